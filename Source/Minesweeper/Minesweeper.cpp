@@ -1,6 +1,30 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "Minesweeper.h"
+#include "MinesweeperBotServer.h"
 #include "Modules/ModuleManager.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE(FDefaultGameModuleImpl, Minesweeper, "Minesweeper");
+LLM_DEFINE_TAG(Minesweeper);
+LLM_DEFINE_TAG(Minesweeper_Grid, NAME_None, TEXT("Minesweeper"));
+LLM_DEFINE_TAG(Minesweeper_Blocks, NAME_None, TEXT("Minesweeper"));
+LLM_DEFINE_TAG(Minesweeper_Generation, NAME_None, TEXT("Minesweeper"));
+LLM_DEFINE_TAG(Minesweeper_History, NAME_None, TEXT("Minesweeper"));
+LLM_DEFINE_TAG(Minesweeper_Simulation, NAME_None, TEXT("Minesweeper"));
+
+class FMinesweeperModule : public FDefaultGameModuleImpl
+{
+public:
+	virtual void StartupModule() override {
+		BotServer = FMinesweeperBotServer::CreateFromCommandLine();
+	}
+
+	virtual void ShutdownModule() override {
+		BotServer.Reset();
+	}
+
+private:
+	/** Lives as long as the module so bots can connect before any world exists */
+	TUniquePtr<FMinesweeperBotServer> BotServer;
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE(FMinesweeperModule, Minesweeper, "Minesweeper");
@@ -3,3 +3,12 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+
+/** Low level memory tracker tags, run with -llm to see them in stat LLM */
+LLM_DECLARE_TAG(Minesweeper);
+LLM_DECLARE_TAG(Minesweeper_Grid);
+LLM_DECLARE_TAG(Minesweeper_Blocks);
+LLM_DECLARE_TAG(Minesweeper_Generation);
+LLM_DECLARE_TAG(Minesweeper_History);
+LLM_DECLARE_TAG(Minesweeper_Simulation);
@@ -0,0 +1,292 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MinesweeperAnalysis.h"
+#include "MinesweeperBoard.h"
+
+FMinesweeperBoardStats FMinesweeperAnalyzer::Analyze(const FMinesweeperBoard& Board, int32 FirstCellIndex) {
+	FMinesweeperBoardStats Stats;
+
+	CountThreeBV(Board, Stats);
+	Stats.Guesses = CountGuesses(Board, FirstCellIndex);
+
+	return Stats;
+}
+
+void FMinesweeperAnalyzer::CountThreeBV(const FMinesweeperBoard& Board, FMinesweeperBoardStats& OutStats) {
+	const int32 NumCells = Board.GetNumCells();
+
+	auto IsZeroCell = [&Board](int32 CellIndex) {
+		return !Board.IsMine(CellIndex) && Board.GetMinesNear(CellIndex) == 0;
+	};
+
+	// Numbered cells outside every opening each take a click of their own, visited marks the rest
+	Visited.Init(false, NumCells);
+
+	OutStats.Openings = Board.GetRegions().GetNumRegions();
+	OutStats.ThreeBV = OutStats.Openings;
+
+	for (int32 CellIndex = 0; CellIndex < NumCells; ++CellIndex) {
+		bool bBordersOpening = Board.IsMine(CellIndex) || IsZeroCell(CellIndex);
+
+		Board.ForEachNeighbour(CellIndex, [&](int32 NeighbourIndex) {
+			bBordersOpening |= IsZeroCell(NeighbourIndex);
+		});
+
+		if (bBordersOpening) {
+			Visited[CellIndex] = true;
+		}
+		else {
+			OutStats.ThreeBV++;
+		}
+	}
+
+	OutStats.Islands = 0;
+
+	for (int32 CellIndex = 0; CellIndex < NumCells; ++CellIndex) {
+		if (Visited[CellIndex]) {
+			continue;
+		}
+
+		OutStats.Islands++;
+
+		Visited[CellIndex] = true;
+		IslandStack.Push(CellIndex);
+
+		while (IslandStack.Num() > 0) {
+			Board.ForEachNeighbour(IslandStack.Pop(false), [this](int32 NeighbourIndex) {
+				if (!Visited[NeighbourIndex]) {
+					Visited[NeighbourIndex] = true;
+					IslandStack.Push(NeighbourIndex);
+				}
+			});
+		}
+	}
+}
+
+int32 FMinesweeperAnalyzer::CountGuesses(const FMinesweeperBoard& Board, int32 FirstCellIndex) {
+	const int32 NumCells = Board.GetNumCells();
+	const int32 SafeCells = NumCells - Board.GetMinesCount();
+
+	Knowledge.Init(ECellKnowledge::Unknown, NumCells);
+	PendingCells.Reset();
+	RevealedCount = 0;
+	FlaggedCount = 0;
+
+	Reveal(Board, FirstCellIndex);
+
+	int32 Guesses = 0;
+
+	while (RevealedCount < SafeCells) {
+		while (PendingCells.Num() > 0) {
+			SolveCell(Board, PendingCells.Pop(false));
+		}
+
+		if (RevealedCount >= SafeCells || SolveSubsets(Board)) {
+			continue;
+		}
+
+		// Mine counter: once every mine is flagged the rest is safe, even cells no number sees
+		if (FlaggedCount == Board.GetMinesCount()) {
+			for (int32 CellIndex = 0; CellIndex < NumCells; ++CellIndex) {
+				Reveal(Board, CellIndex);
+			}
+
+			continue;
+		}
+
+		// Stuck, the solver guesses a safe cell next to what it knows, or anywhere if nothing is next to it
+		Guesses++;
+
+		int32 GuessIndex = INDEX_NONE;
+
+		for (int32 CellIndex = 0; CellIndex < NumCells; ++CellIndex) {
+			if (Knowledge[CellIndex] != ECellKnowledge::Unknown || Board.IsMine(CellIndex)) {
+				continue;
+			}
+
+			bool bOnFrontier = false;
+
+			Board.ForEachNeighbour(CellIndex, [this, &bOnFrontier](int32 NeighbourIndex) {
+				bOnFrontier |= Knowledge[NeighbourIndex] == ECellKnowledge::Revealed;
+			});
+
+			if (bOnFrontier || GuessIndex == INDEX_NONE) {
+				GuessIndex = CellIndex;
+			}
+
+			if (bOnFrontier) {
+				break;
+			}
+		}
+
+		Reveal(Board, GuessIndex);
+	}
+
+	return Guesses;
+}
+
+void FMinesweeperAnalyzer::Reveal(const FMinesweeperBoard& Board, int32 CellIndex) {
+	if (Knowledge[CellIndex] != ECellKnowledge::Unknown) {
+		return;
+	}
+
+	const int32 Region = Board.GetRegions().FindRegion(CellIndex);
+
+	if (Region == INDEX_NONE) {
+		Knowledge[CellIndex] = ECellKnowledge::Revealed;
+		RevealedCount++;
+		QueueNeighbours(Board, CellIndex);
+		return;
+	}
+
+	for (int32 RegionCellIndex : Board.GetRegions().GetRegionCells(Region)) {
+		if (Knowledge[RegionCellIndex] == ECellKnowledge::Unknown) {
+			Knowledge[RegionCellIndex] = ECellKnowledge::Revealed;
+			RevealedCount++;
+			QueueNeighbours(Board, RegionCellIndex);
+		}
+	}
+}
+
+void FMinesweeperAnalyzer::Flag(const FMinesweeperBoard& Board, int32 CellIndex) {
+	if (Knowledge[CellIndex] != ECellKnowledge::Unknown) {
+		return;
+	}
+
+	Knowledge[CellIndex] = ECellKnowledge::Flagged;
+	FlaggedCount++;
+	QueueNeighbours(Board, CellIndex);
+}
+
+bool FMinesweeperAnalyzer::SolveCell(const FMinesweeperBoard& Board, int32 CellIndex) {
+	int32 Unknowns[8];
+	int32 HiddenMines = 0;
+	const int32 NumUnknowns = GatherUnknowns(Board, CellIndex, Unknowns, HiddenMines);
+
+	if (NumUnknowns == 0) {
+		return false;
+	}
+
+	if (HiddenMines == 0) {
+		for (int32 i = 0; i < NumUnknowns; ++i) {
+			Reveal(Board, Unknowns[i]);
+		}
+
+		return true;
+	}
+
+	if (HiddenMines == NumUnknowns) {
+		for (int32 i = 0; i < NumUnknowns; ++i) {
+			Flag(Board, Unknowns[i]);
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
+bool FMinesweeperAnalyzer::SolveSubsets(const FMinesweeperBoard& Board) {
+	const int32 Size = Board.GetSize();
+
+	for (int32 CellIndex = 0; CellIndex < Board.GetNumCells(); ++CellIndex) {
+		if (Knowledge[CellIndex] != ECellKnowledge::Revealed || Board.GetMinesNear(CellIndex) == 0) {
+			continue;
+		}
+
+		int32 Unknowns[8];
+		int32 HiddenMines = 0;
+		const int32 NumUnknowns = GatherUnknowns(Board, CellIndex, Unknowns, HiddenMines);
+
+		if (NumUnknowns == 0) {
+			continue;
+		}
+
+		// Only numbers up to two cells away can share unknowns
+		const int32 Row = CellIndex / Size;
+		const int32 Column = CellIndex % Size;
+
+		for (int32 OtherRow = FMath::Max(Row - 2, 0); OtherRow <= FMath::Min(Row + 2, Size - 1); ++OtherRow) {
+			for (int32 OtherColumn = FMath::Max(Column - 2, 0); OtherColumn <= FMath::Min(Column + 2, Size - 1); ++OtherColumn) {
+				const int32 OtherIndex = OtherRow * Size + OtherColumn;
+
+				if (OtherIndex == CellIndex || Knowledge[OtherIndex] != ECellKnowledge::Revealed || Board.GetMinesNear(OtherIndex) == 0) {
+					continue;
+				}
+
+				int32 OtherUnknowns[8];
+				int32 OtherHiddenMines = 0;
+				const int32 NumOtherUnknowns = GatherUnknowns(Board, OtherIndex, OtherUnknowns, OtherHiddenMines);
+
+				if (NumOtherUnknowns <= NumUnknowns) {
+					continue;
+				}
+
+				const TArrayView<int32> OtherUnknownsView(OtherUnknowns, NumOtherUnknowns);
+				bool bSubset = true;
+
+				for (int32 i = 0; i < NumUnknowns && bSubset; ++i) {
+					bSubset = OtherUnknownsView.Contains(Unknowns[i]);
+				}
+
+				if (!bSubset) {
+					continue;
+				}
+
+				// Cells only the other number sees hold exactly the mines this number does not explain
+				const TArrayView<int32> UnknownsView(Unknowns, NumUnknowns);
+				const int32 RestMines = OtherHiddenMines - HiddenMines;
+				const int32 NumRest = NumOtherUnknowns - NumUnknowns;
+
+				if (RestMines != 0 && RestMines != NumRest) {
+					continue;
+				}
+
+				for (int32 i = 0; i < NumOtherUnknowns; ++i) {
+					if (UnknownsView.Contains(OtherUnknowns[i])) {
+						continue;
+					}
+
+					if (RestMines == 0) {
+						Reveal(Board, OtherUnknowns[i]);
+					}
+					else {
+						Flag(Board, OtherUnknowns[i]);
+					}
+				}
+
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+int32 FMinesweeperAnalyzer::GatherUnknowns(const FMinesweeperBoard& Board, int32 CellIndex, int32 (&OutUnknowns)[8], int32& OutHiddenMines) const {
+	int32 NumUnknowns = 0;
+	OutHiddenMines = Board.GetMinesNear(CellIndex);
+
+	Board.ForEachNeighbour(CellIndex, [&](int32 NeighbourIndex) {
+		if (Knowledge[NeighbourIndex] == ECellKnowledge::Unknown) {
+			OutUnknowns[NumUnknowns++] = NeighbourIndex;
+		}
+		else if (Knowledge[NeighbourIndex] == ECellKnowledge::Flagged) {
+			OutHiddenMines--;
+		}
+	});
+
+	return NumUnknowns;
+}
+
+void FMinesweeperAnalyzer::QueueNeighbours(const FMinesweeperBoard& Board, int32 CellIndex) {
+	if (Knowledge[CellIndex] == ECellKnowledge::Revealed && Board.GetMinesNear(CellIndex) > 0) {
+		PendingCells.Push(CellIndex);
+	}
+
+	Board.ForEachNeighbour(CellIndex, [this, &Board](int32 NeighbourIndex) {
+		if (Knowledge[NeighbourIndex] == ECellKnowledge::Revealed && Board.GetMinesNear(NeighbourIndex) > 0) {
+			PendingCells.Push(NeighbourIndex);
+		}
+	});
+}
@@ -0,0 +1,67 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FMinesweeperBoard;
+
+/** Difficulty metrics of a generated board */
+struct FMinesweeperBoardStats
+{
+	/** Minimum clicks needed to clear the board: openings plus numbered cells outside them */
+	int32 ThreeBV{ 0 };
+
+	/** Connected zero regions */
+	int32 Openings{ 0 };
+
+	/** Connected groups of numbered cells that border no opening */
+	int32 Islands{ 0 };
+
+	/** Times a logical solver got stuck and had to guess */
+	int32 Guesses{ 0 };
+};
+
+/**
+ * Computes FMinesweeperBoardStats.
+ * Keeps its scratch buffers between boards, so one analyzer per thread can go through many seeds cheaply.
+ */
+class FMinesweeperAnalyzer
+{
+public:
+	/** Board must have its mines placed, FirstCellIndex is where the solver starts */
+	FMinesweeperBoardStats Analyze(const FMinesweeperBoard& Board, int32 FirstCellIndex);
+
+private:
+	enum class ECellKnowledge : uint8
+	{
+		Unknown,
+		Revealed,
+		Flagged
+	};
+
+	void CountThreeBV(const FMinesweeperBoard& Board, FMinesweeperBoardStats& OutStats);
+	int32 CountGuesses(const FMinesweeperBoard& Board, int32 FirstCellIndex);
+
+	void Reveal(const FMinesweeperBoard& Board, int32 CellIndex);
+	void Flag(const FMinesweeperBoard& Board, int32 CellIndex);
+
+	/** Single cell rules: all mines found or all unknowns are mines */
+	bool SolveCell(const FMinesweeperBoard& Board, int32 CellIndex);
+
+	/** Two cell rule: unknowns of one number are a subset of another's */
+	bool SolveSubsets(const FMinesweeperBoard& Board);
+
+	/** Unknown neighbours of a revealed cell and how many mines are still hidden among them */
+	int32 GatherUnknowns(const FMinesweeperBoard& Board, int32 CellIndex, int32 (&OutUnknowns)[8], int32& OutHiddenMines) const;
+
+	/** Pushes revealed numbered neighbours whose unknowns just changed */
+	void QueueNeighbours(const FMinesweeperBoard& Board, int32 CellIndex);
+
+	TArray<ECellKnowledge> Knowledge;
+	TArray<int32> PendingCells;
+	TArray<int32> IslandStack;
+	TBitArray<> Visited;
+	int32 RevealedCount{ 0 };
+	int32 FlaggedCount{ 0 };
+};
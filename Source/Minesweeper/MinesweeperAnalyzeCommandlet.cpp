@@ -0,0 +1,124 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MinesweeperAnalyzeCommandlet.h"
+#include "MinesweeperAnalysis.h"
+#include "MinesweeperBoard.h"
+#include "Async/ParallelFor.h"
+#include "Misc/FileHelper.h"
+
+/** Seeds analyzed by a single task, each task reuses one board and one analyzer */
+static constexpr int32 SeedsPerBatch = 256;
+
+UMinesweeperAnalyzeCommandlet::UMinesweeperAnalyzeCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UMinesweeperAnalyzeCommandlet::Main(const FString& Params)
+{
+	int32 Size = 16;
+	int32 MinesCount = 40;
+	int32 NumSeeds = 10000;
+	int32 FirstSeed = 1;
+	FString OutputPath;
+
+	FParse::Value(*Params, TEXT("Size="), Size);
+	FParse::Value(*Params, TEXT("Mines="), MinesCount);
+	FParse::Value(*Params, TEXT("Seeds="), NumSeeds);
+	FParse::Value(*Params, TEXT("FirstSeed="), FirstSeed);
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+	Size = FMath::Clamp(Size, 1, FMinesweeperBoard::MaxSize);
+	NumSeeds = FMath::Max(NumSeeds, 1);
+
+	// Seed 0 makes the board pick one from the clock, every reported seed has to replay the same board
+	if (FirstSeed <= 0 || FirstSeed > MAX_int32 - (NumSeeds - 1)) {
+		UE_LOG(LogTemp, Error, TEXT("Seeds %d to %lld are out of range, they have to be between 1 and %d"),
+			FirstSeed, int64(FirstSeed) + NumSeeds - 1, MAX_int32);
+		return 1;
+	}
+
+	// Boards are opened in the middle, the cell the generator keeps free of mines
+	const int32 FirstCellIndex = (Size / 2) * Size + Size / 2;
+
+	TArray<FMinesweeperBoardStats> Results;
+	Results.SetNum(NumSeeds);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	ParallelFor(FMath::DivideAndRoundUp(NumSeeds, SeedsPerBatch), [&](int32 BatchIndex) {
+		FMinesweeperBoard Board;
+		Board.bPracticeMode = false;
+
+		FMinesweeperAnalyzer Analyzer;
+		TArray<FMinesweeperCellDiff> Diffs;
+
+		const int32 LastSeedIndex = FMath::Min((BatchIndex + 1) * SeedsPerBatch, NumSeeds);
+
+		for (int32 SeedIndex = BatchIndex * SeedsPerBatch; SeedIndex < LastSeedIndex; ++SeedIndex) {
+			Diffs.Reset();
+			Board.Reset(Size, MinesCount, FirstSeed + SeedIndex, Diffs);
+			Board.PlaceMines(FirstCellIndex);
+
+			Results[SeedIndex] = Analyzer.Analyze(Board, FirstCellIndex);
+		}
+	});
+
+	const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+	UE_LOG(LogTemp, Display, TEXT("Analyzed %d boards %dx%d with %d mines in %.2fs (%.0f boards/s)"),
+		NumSeeds, Size, Size, MinesCount, Seconds, NumSeeds / FMath::Max(Seconds, 1e-6));
+
+	auto LogMetric = [&Results](const TCHAR* Name, int32 FMinesweeperBoardStats::* Metric) {
+		TArray<int32> Values;
+		Values.Reserve(Results.Num());
+
+		int64 Sum = 0;
+
+		for (const FMinesweeperBoardStats& Stats : Results) {
+			Values.Add(Stats.*Metric);
+			Sum += Stats.*Metric;
+		}
+
+		Values.Sort();
+
+		auto Percentile = [&Values](int32 Percent) {
+			return Values[(Values.Num() - 1) * Percent / 100];
+		};
+
+		UE_LOG(LogTemp, Display, TEXT("  %-9s mean %8.2f  min %5d  p10 %5d  p50 %5d  p90 %5d  max %5d"),
+			Name, double(Sum) / Values.Num(), Values[0], Percentile(10), Percentile(50), Percentile(90), Values.Last());
+	};
+
+	LogMetric(TEXT("3BV"), &FMinesweeperBoardStats::ThreeBV);
+	LogMetric(TEXT("Openings"), &FMinesweeperBoardStats::Openings);
+	LogMetric(TEXT("Islands"), &FMinesweeperBoardStats::Islands);
+	LogMetric(TEXT("Guesses"), &FMinesweeperBoardStats::Guesses);
+
+	const int32 NoGuessBoards = Results.FilterByPredicate([](const FMinesweeperBoardStats& Stats) {
+		return Stats.Guesses == 0;
+	}).Num();
+
+	UE_LOG(LogTemp, Display, TEXT("  Solvable without guessing: %.2f%%"), 100.0 * NoGuessBoards / NumSeeds);
+
+	if (!OutputPath.IsEmpty()) {
+		TArray<FString> Lines;
+		Lines.Reserve(NumSeeds + 1);
+		Lines.Add(TEXT("Seed,3BV,Openings,Islands,Guesses"));
+
+		for (int32 SeedIndex = 0; SeedIndex < NumSeeds; ++SeedIndex) {
+			const FMinesweeperBoardStats& Stats = Results[SeedIndex];
+			Lines.Add(FString::Printf(TEXT("%d,%d,%d,%d,%d"), FirstSeed + SeedIndex, Stats.ThreeBV, Stats.Openings, Stats.Islands, Stats.Guesses));
+		}
+
+		if (!FFileHelper::SaveStringArrayToFile(Lines, *OutputPath)) {
+			UE_LOG(LogTemp, Error, TEXT("Could not write [%s]"), *OutputPath);
+			return 1;
+		}
+	}
+
+	return 0;
+}
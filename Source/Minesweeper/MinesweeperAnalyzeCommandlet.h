@@ -0,0 +1,25 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MinesweeperAnalyzeCommandlet.generated.h"
+
+/**
+ * Generates boards for a range of seeds and reports their difficulty.
+ * Usage: -run=MinesweeperAnalyze -Size=16 -Mines=40 -Seeds=1000000 [-FirstSeed=1] [-Output=Stats.csv]
+ * Seeds run from FirstSeed and must stay positive, so every board in the output can be replayed.
+ */
+UCLASS()
+class UMinesweeperAnalyzeCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UMinesweeperAnalyzeCommandlet();
+
+	// Begin UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+	// End UCommandlet interface
+};
@@ -5,6 +5,7 @@
 #include "UObject/ConstructorHelpers.h"
 #include "Components/StaticMeshComponent.h"
 #include "Engine/StaticMesh.h"
+#include "Materials/Material.h"
 #include "Materials/MaterialInstance.h"
 #include "Components/TextRenderComponent.h"
 
@@ -61,53 +62,10 @@ AMinesweeperBlock::AMinesweeperBlock()
 	MinesNearMeCountText->SetVisibility(false);
 }
 
-void AMinesweeperBlock::CheckBlock()
-{
-	if (CurrentRole == BlockRole::NONE) {
-		CurrentRole = BlockRole::BLANK;
-
-		if (OwningGrid) {
-			OwningGrid->FirstTouch();
-		}
-	}
-	else if (CurrentRole == BlockRole::MINE) {
-		
-		if (OwningGrid) {
-			OwningGrid->RevealAll();
-		}
-
-		return;
-	}
-
-	if (CurrentState != BlockState::REVEALED) {
-		Reveal();
-
-		if (MinesNearMeCount == 0) {
-			if (OwningGrid) {
-				OwningGrid->BlankTouched(BlockIndex);
-			}
-		}
-	}
-}
-
-void AMinesweeperBlock::MarkBlock()
-{
-	if (CurrentState == BlockState::IDLE)
-	{
-		CurrentState = BlockState::MARKED;
-
-		// Change material
-		BlockMesh->SetMaterial(0, BrownMaterial);
-	} else if (CurrentState == BlockState::MARKED) {
-		// Change material
-		BlockMesh->SetMaterial(0, BaseMaterial);
-
-		CurrentState = BlockState::IDLE;
-	}
-}
-
 void AMinesweeperBlock::Highlight(bool bOn)
 {
+	bHighlighted = bOn;
+
 	// Do not highlight if the block has already been activated.
 	if (CurrentState!= BlockState::IDLE)
 	{
@@ -124,50 +82,73 @@ void AMinesweeperBlock::Highlight(bool bOn)
 	}
 }
 
-void AMinesweeperBlock::Reveal() {
+void AMinesweeperBlock::ApplyCell(BlockState State, int MinesNear, bool bMine) {
+	const BlockRole Role = bMine ? BlockRole::MINE : BlockRole::BLANK;
 
-	if (CurrentState == BlockState::REVEALED) {
+	// Resets and undos send many cells that already look right, those cost no render state update
+	if (State == CurrentState && Role == CurrentRole && MinesNear == MinesNearMeCount) {
 		return;
 	}
 
-	switch (CurrentRole)
-	{
-	case BlockRole::NONE:
-		GetBlockMesh()->SetMaterial(0, BaseMaterial);
-		CurrentState = BlockState::IDLE;
-		break;
-	case BlockRole::BLANK:
-		GetBlockMesh()->SetMaterial(0, OrangeMaterial);
-		break;
-	case BlockRole::MINE:
-		GetBlockMesh()->SetMaterial(0, RedMaterial);
-		break;
-	default:
-		break;
+	const bool bWasTextVisible = CurrentState == BlockState::REVEALED && CurrentRole != BlockRole::MINE && MinesNearMeCount > 0;
+
+	if (State != CurrentState || Role != CurrentRole) {
+		CurrentState = State;
+		CurrentRole = Role;
+
+		switch (State)
+		{
+		case BlockState::IDLE:
+			BlockMesh->SetMaterial(0, bHighlighted ? BaseMaterial : BlueMaterial);
+			break;
+		case BlockState::MARKED:
+			BlockMesh->SetMaterial(0, BrownMaterial);
+			break;
+		case BlockState::REVEALED:
+			BlockMesh->SetMaterial(0, GetRevealedMaterial());
+			break;
+		default:
+			break;
+		}
+	}
+
+	const bool bTextVisible = State == BlockState::REVEALED && !bMine && MinesNear > 0;
+
+	// Hidden text is only updated once it is shown again
+	if (bTextVisible && MinesNear != MinesNearMeTextCount) {
+		MinesNearMeTextCount = MinesNear;
+		MinesNearMeCountText->SetText(FText::AsNumber(MinesNearMeTextCount));
 	}
 
-	CurrentState = BlockState::REVEALED;
+	MinesNearMeCount = MinesNear;
 
-	if(MinesNearMeCount>0) {
-		MinesNearMeCountText->SetVisibility(true);
+	if (bTextVisible != bWasTextVisible) {
+		MinesNearMeCountText->SetVisibility(bTextVisible);
 	}
 }
 
-void AMinesweeperBlock::SetRole(BlockRole role) {
-	CurrentRole = role;
+void AMinesweeperBlock::SetPooled(bool bPooled) {
+	SetActorHiddenInGame(bPooled);
+	SetActorEnableCollision(!bPooled);
 
-	if (role == BlockRole::MINE) {
-		MinesNearMeCount = 0;
-		MinesNearMeCountText->SetText(FText::AsNumber(0));
+	if (bPooled) {
+		BlockIndex = -1;
+		bHighlighted = false;
+	}
+}
+
+UMaterialInterface* AMinesweeperBlock::GetRevealedMaterial() const {
+	switch (CurrentRole)
+	{
+	case BlockRole::BLANK:
+		return OrangeMaterial;
+	case BlockRole::MINE:
+		return RedMaterial;
+	default:
+		return BaseMaterial;
 	}
 }
 
 BlockRole AMinesweeperBlock::GetRole() const {
 	return CurrentRole;
 }
-
-void AMinesweeperBlock::IncreaseMineNearMeCount() {
-	MinesNearMeCount++;
-
-	MinesNearMeCountText->SetText(FText::AsNumber(MinesNearMeCount));
-}
\ No newline at end of file
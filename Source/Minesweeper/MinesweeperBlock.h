@@ -39,15 +39,23 @@ private:
 	UPROPERTY()
 	BlockState CurrentState{ BlockState::IDLE };
 
-	/** Current state */
+	/** Current role, blocks stay blank until the board places mines */
 	UPROPERTY()
-	BlockRole CurrentRole{ BlockRole::NONE };
+	BlockRole CurrentRole{ BlockRole::BLANK };
 
 	int MinesNearMeCount{ 0 };
 
+	/** Number MinesNearMeCountText currently shows */
+	int MinesNearMeTextCount{ 0 };
+
+	/** Under the cursor, kept so idle visuals applied later stay highlighted */
+	bool bHighlighted{ false };
+
 	UPROPERTY(Category = Grid, VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
 	class UTextRenderComponent* MinesNearMeCountText;
 
+	class UMaterialInterface* GetRevealedMaterial() const;
+
 public:
 
 	AMinesweeperBlock();
@@ -79,21 +87,20 @@ public:
 	UPROPERTY()
 	int BlockIndex{-1};
 
-	void CheckBlock();
-	void MarkBlock();
-
 	void Highlight(bool bOn);
-	void Reveal();
 
-	void SetRole(BlockRole role);
+	/** Shows the cell as simulated by the board */
+	void ApplyCell(BlockState State, int MinesNear, bool bMine);
+
+	/** Hides the block while it waits in the grid pool */
+	void SetPooled(bool bPooled);
+
 	BlockRole GetRole() const;
 
 	BlockState GetState() const{
 		return CurrentState;
 	}
 
-	void IncreaseMineNearMeCount();
-
 	int GetMinesNearMe() {
 		return MinesNearMeCount;
 	}
@@ -1,22 +1,64 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "MinesweeperBlockGrid.h"
+#include "Minesweeper.h"
 #include "MinesweeperBlock.h"
+#include "MinesweeperSimulation.h"
 #include "Engine/World.h"
+#include "EngineUtils.h"
+#include "Components/StaticMeshComponent.h"
+#include "Components/TextRenderComponent.h"
+#include "Serialization/ArchiveCountMem.h"
 
 #define LOCTEXT_NAMESPACE "PuzzleBlockGrid"
 
-static const TMap<FString, TPair<int, int>> nearMe{ {"Top", TPair<int,int>{1,0}},
-								 {"TopLeft", TPair<int,int>{1,-1}},
-								 {"TopRight", TPair<int,int>{1,1}},
-								 {"Bottom", TPair<int,int>{-1,0}},
-								 {"BottomLeft", TPair<int,int>{-1,-1}},
-								 {"BottomRight", TPair<int,int>{-1,1}},
-								 {"Left",TPair<int,int>{0,-1}},
-								 {"Right",TPair<int,int>{0,1}} };
+static TAutoConsoleVariable<int32> CVarMaxBlockUpdatesPerFrame(
+	TEXT("Minesweeper.MaxBlockUpdatesPerFrame"),
+	4096,
+	TEXT("How many blocks may change their visuals in a single frame, the rest waits for the next frames."));
+
+static TAutoConsoleVariable<int32> CVarMemoryBudgetPerCell(
+	TEXT("Minesweeper.MemoryBudgetPerCell"),
+	0,
+	TEXT("Memory budget of a single cell in bytes, checked when the board changes size. 0 disables the check."));
+
+static FAutoConsoleCommandWithWorld MemReportCommand(
+	TEXT("Minesweeper.MemReport"),
+	TEXT("Prints bytes per cell of the current board by category"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World) {
+		for (TActorIterator<AMinesweeperBlockGrid> It(World); It; ++It) {
+			It->RequestMemoryReport();
+		}
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs NewGameCommand(
+	TEXT("Minesweeper.NewGame"),
+	TEXT("Starts a new game on the existing grid: Minesweeper.NewGame [Size] [MinesCount] [Seed]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World) {
+		for (TActorIterator<AMinesweeperBlockGrid> It(World); It; ++It) {
+			const int32 NewSize = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : It->Size;
+			const int32 NewMinesCount = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : It->MinesCount;
+			const int32 NewSeed = Args.Num() > 2 ? FCString::Atoi(*Args[2]) : 0;
+
+			It->ResetBoard(NewSize, NewMinesCount, NewSeed);
+		}
+	}));
+
+static SIZE_T CountObjectBytes(UObject* Object) {
+	if (!Object) {
+		return 0;
+	}
+
+	FArchiveCountMem Counter(Object);
+
+	return Counter.GetMax() + Object->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+}
 
 AMinesweeperBlockGrid::AMinesweeperBlockGrid()
 {
+	// Block visuals follow the simulation every frame
+	PrimaryActorTick.bCanEverTick = true;
+
 	// Create dummy root scene component
 	DummyRoot = CreateDefaultSubobject<USceneComponent>(TEXT("Dummy0"));
 	RootComponent = DummyRoot;
@@ -25,10 +67,14 @@ AMinesweeperBlockGrid::AMinesweeperBlockGrid()
 	Size = 8;
 	BlockSpacing = 0;
 	MinesCount = 10;
+	bPracticeMode = false;
+	Seed = 0;
 }
 
 void AMinesweeperBlockGrid::BeginPlay()
 {
+	LLM_SCOPE_BYTAG(Minesweeper_Grid);
+
 	Super::BeginPlay();
 
 	const FString JsonFilePath = FPaths::ProjectContentDir() + "/Settings/FieldSettings.json";
@@ -52,6 +98,12 @@ void AMinesweeperBlockGrid::BeginPlay()
 			if (JsonObject->GetIntegerField("MinesCount") != NULL) {
 				MinesCount = JsonObject->GetIntegerField("MinesCount");
 			}
+
+			// Set practice mode if exists
+			JsonObject->TryGetBoolField("PracticeMode", bPracticeMode);
+
+			// Set mines seed if exists
+			JsonObject->TryGetNumberField("Seed", Seed);
 		}
 	}
 	else
@@ -59,116 +111,318 @@ void AMinesweeperBlockGrid::BeginPlay()
 		UE_LOG(LogTemp, Warning, TEXT("There is no file with path [%s]"), *JsonFilePath);
 	}
 	
-	// Number of blocks
-	const int32 NumBlocks = Size * Size;
+	Simulation = MakeUnique<FMinesweeperSimulation>(bPracticeMode);
+
+	ResetBoard(Size, MinesCount, Seed);
+}
+
+void AMinesweeperBlockGrid::EndPlay(const EEndPlayReason::Type EndPlayReason) {
+	Simulation.Reset();
+	bHasPendingDiffs = false;
+	NewGamesInFlight = 0;
+
+	Super::EndPlay(EndPlayReason);
+}
 
-	if (NumBlocks <= MinesCount) {
-		MinesCount = NumBlocks - 1;
+void AMinesweeperBlockGrid::ResetBoard(int32 NewSize, int32 NewMinesCount, int32 NewSeed) {
+	FMinesweeperCommand Command{ EMinesweeperCommandType::NewGame };
+	Command.Size = FMath::Clamp(NewSize, 1, FMinesweeperBoard::MaxSize);
+	Command.MinesCount = NewMinesCount;
+	Command.Seed = NewSeed;
+
+	if (EnqueueCommand(Command)) {
+		Seed = NewSeed;
+		NewGamesInFlight++;
 	}
+}
 
-	FVector origin{0,0,0}, extent{0,0,0};
+void AMinesweeperBlockGrid::CheckBlock(int32 BlockIndex) {
+	FMinesweeperCommand Command{ EMinesweeperCommandType::Check };
+	Command.CellIndex = BlockIndex;
 
-	// Loop to spawn each block
-	for(int32 BlockIndex=0; BlockIndex<NumBlocks; BlockIndex++)
-	{
-		const float XOffset = (BlockIndex / Size) * (extent.X*2 + BlockSpacing); // Divide by dimension
-		const float YOffset = (BlockIndex % Size) * (extent.Y*2 + BlockSpacing); // Modulo gives remainder
+	EnqueueCommand(Command);
+}
 
-		// Make position vector, offset from Grid location
-		const FVector BlockLocation = FVector(XOffset, YOffset, 0.f) + GetActorLocation();
+void AMinesweeperBlockGrid::MarkBlock(int32 BlockIndex) {
+	FMinesweeperCommand Command{ EMinesweeperCommandType::Mark };
+	Command.CellIndex = BlockIndex;
 
-		// Spawn a block
-		AMinesweeperBlock*  NewBlock = GetWorld()->SpawnActor<AMinesweeperBlock>(BlockLocation, FRotator(0,0,0));
+	EnqueueCommand(Command);
+}
 
-		NewBlock->GetActorBounds(false, origin, extent);
+void AMinesweeperBlockGrid::ChordBlock(int32 BlockIndex) {
+	FMinesweeperCommand Command{ EMinesweeperCommandType::Chord };
+	Command.CellIndex = BlockIndex;
 
-		// Tell the block about its owner
-		if (NewBlock != nullptr)
-		{
-			NewBlock->OwningGrid = this;
-			NewBlock->BlockIndex = BlockIndex;
-		}
+	EnqueueCommand(Command);
+}
 
-		MinesweeperBlocks.Add(NewBlock);
+void AMinesweeperBlockGrid::UndoMove() {
+	if (bPracticeMode) {
+		EnqueueCommand({ EMinesweeperCommandType::Undo });
 	}
 }
 
-void AMinesweeperBlockGrid::Tick(float DeltaTime) {
-	//if (timerWidget) {
-	//	UE_LOG(LogTemp, Warning, TEXT("Done"));
+void AMinesweeperBlockGrid::RedoMove() {
+	if (bPracticeMode) {
+		EnqueueCommand({ EMinesweeperCommandType::Redo });
+	}
+}
 
-	//	timerWidget->TimerText->SetText(FText::FromString("Penis"));
-	//}
+void AMinesweeperBlockGrid::RequestMemoryReport() {
+	EnqueueCommand({ EMinesweeperCommandType::ReportMemory });
 }
 
-void AMinesweeperBlockGrid::FirstTouch() {
-	GetWorld()->GetAuthGameMode();
-	FRandomStream stream(FDateTime::Now().ToUnixTimestamp());
+bool AMinesweeperBlockGrid::EnqueueCommand(FMinesweeperCommand Command) {
+	// Console commands and Blueprints may reach a grid in an editor world that never began play
+	if (!Simulation) {
+		return false;
+	}
+
+	Command.Generation = BoardGeneration;
+
+	Simulation->EnqueueCommand(Command);
+
+	return true;
+}
 
-	for (int i = 0; i < MinesCount; ++i) {
-		int index = stream.RandRange(0, MinesweeperBlocks.Num() - 1);
-		
-		auto mineBlock = MinesweeperBlocks[index];
+void AMinesweeperBlockGrid::ApplyNewBoard(int32 NewSize, int32 NewMinesCount) {
+	LLM_SCOPE_BYTAG(Minesweeper_Grid);
 
-		while (mineBlock->GetRole() != BlockRole::NONE){
-			index = stream.RandRange(0, MinesweeperBlocks.Num() - 1);
-			mineBlock = MinesweeperBlocks[index];
+	BoardGeneration++;
+
+	Size = FMath::Clamp(NewSize, 1, FMinesweeperBoard::MaxSize);
+	MinesCount = NewMinesCount;
+
+	if (Size != BuiltSize) {
+		ResizeBlocks();
+
+		// The report walks every block, so the budget is only checked when the block count changes
+		if (CVarMemoryBudgetPerCell.GetValueOnGameThread() > 0) {
+			ReportMemory();
 		}
+	}
+}
+
+void AMinesweeperBlockGrid::ResizeBlocks() {
+	const int32 NumBlocks = Size * Size;
+	const int32 KeptSize = FMath::Min(Size, BuiltSize);
 
-		mineBlock->SetRole(BlockRole::MINE);
-		
-		int row = index / Size;
-		int column = index % Size;
+	TArray<AMinesweeperBlock*> NewBlocks;
+	NewBlocks.SetNumUninitialized(NumBlocks);
 
-		for (auto el : nearMe) {
-			int rowToCheck = row + el.Value.Key;
-			int columnToCheck = column + el.Value.Value;
-			int blockIndexToCheck = rowToCheck * Size + columnToCheck;
+	// Blocks keep their row and column, so only the rows and columns outside the old board move
+	for (int32 Row = 0; Row < BuiltSize; ++Row) {
+		for (int32 Column = 0; Column < BuiltSize; ++Column) {
+			AMinesweeperBlock* Block = MinesweeperBlocks[Row * BuiltSize + Column];
 
-			if (!isOutOfSizeBounds(rowToCheck) && !isOutOfSizeBounds(columnToCheck) && MinesweeperBlocks[blockIndexToCheck]->GetRole() != BlockRole::MINE) {
-				MinesweeperBlocks[blockIndexToCheck]->IncreaseMineNearMeCount();
+			if (Row < KeptSize && Column < KeptSize) {
+				NewBlocks[Row * Size + Column] = Block;
+			}
+			else {
+				Block->SetPooled(true);
+				BlockPool.Push(Block);
 			}
 		}
 	}
 
-	for (auto block : MinesweeperBlocks) {
-		if (block->GetRole() == BlockRole::NONE) {
-			block->SetRole(BlockRole::BLANK);
+	for (int32 Row = 0; Row < Size; ++Row) {
+		for (int32 Column = 0; Column < Size; ++Column) {
+			if (Row < KeptSize && Column < KeptSize) {
+				continue;
+			}
+
+			AMinesweeperBlock* Block = nullptr;
+
+			if (BlockPool.Num() > 0) {
+				Block = BlockPool.Pop(false);
+				Block->SetActorLocation(GetBlockLocation(Row, Column));
+				Block->SetPooled(false);
+			}
+			else {
+				Block = SpawnBlock(Row, Column);
+			}
+
+			NewBlocks[Row * Size + Column] = Block;
 		}
 	}
+
+	for (int32 BlockIndex = 0; BlockIndex < NumBlocks; ++BlockIndex) {
+		NewBlocks[BlockIndex]->BlockIndex = BlockIndex;
+	}
+
+	MinesweeperBlocks = MoveTemp(NewBlocks);
+	BuiltSize = Size;
 }
 
-void AMinesweeperBlockGrid::RevealAll() {
-	for (auto block : MinesweeperBlocks) {
-		block->Reveal();
+AMinesweeperBlock* AMinesweeperBlockGrid::SpawnBlock(int32 Row, int32 Column) {
+	LLM_SCOPE_BYTAG(Minesweeper_Blocks);
+
+	// Spawn a block
+	AMinesweeperBlock* NewBlock = GetWorld()->SpawnActor<AMinesweeperBlock>(GetBlockLocation(Row, Column), FRotator(0,0,0));
+
+	// Tell the block about its owner
+	if (NewBlock != nullptr)
+	{
+		NewBlock->OwningGrid = this;
+
+		// Block size is only known once the first one exists
+		if (BlockExtent.IsZero()) {
+			FVector Origin;
+			NewBlock->GetActorBounds(false, Origin, BlockExtent);
+		}
 	}
+
+	return NewBlock;
+}
+
+FVector AMinesweeperBlockGrid::GetBlockLocation(int32 Row, int32 Column) const {
+	const float XOffset = Row * (BlockExtent.X * 2 + BlockSpacing);
+	const float YOffset = Column * (BlockExtent.Y * 2 + BlockSpacing);
+
+	// Make position vector, offset from Grid location
+	return FVector(XOffset, YOffset, 0.f) + GetActorLocation();
 }
 
-void AMinesweeperBlockGrid::BlankTouched(int BlockIndex) {
-	if (MinesweeperBlocks[BlockIndex]->GetMinesNearMe() != 0) {
+void AMinesweeperBlockGrid::Tick(float DeltaTime) {
+	Super::Tick(DeltaTime);
+
+	if (!Simulation) {
 		return;
 	}
 
-	int row = BlockIndex / Size;
-	int column = BlockIndex % Size;
+	int32 Budget = FMath::Max(CVarMaxBlockUpdatesPerFrame.GetValueOnGameThread(), 1);
+
+	// Big openings are spread over several frames so input stays responsive
+	while (Budget > 0) {
+		if (!bHasPendingDiffs) {
+			if (!Simulation->DequeueDiffs(PendingDiffs)) {
+				break;
+			}
+
+			PendingDiffsOffset = 0;
+			bHasPendingDiffs = true;
+		}
+
+		// A new game goes out in one frame, the old layout is reset and the board resized before any other click
+		if (PendingDiffs.NewSize > 0) {
+			for (const FMinesweeperCellDiff& Diff : PendingDiffs.Cells) {
+				MinesweeperBlocks[Diff.CellIndex]->ApplyCell(Diff.State, Diff.MinesNear, Diff.bMine);
+			}
+
+			bHasPendingDiffs = false;
+			NewGamesInFlight--;
+			BoardAllocatedSize = PendingDiffs.BoardAllocatedSize;
+
+			ApplyNewBoard(PendingDiffs.NewSize, PendingDiffs.NewMinesCount);
+			continue;
+		}
+
+		if (PendingDiffs.bReportMemory) {
+			bHasPendingDiffs = false;
+			BoardAllocatedSize = PendingDiffs.BoardAllocatedSize;
 
-	for (auto el : nearMe) {
-		int rowToCheck = row + el.Value.Key;
-		int columnToCheck = column + el.Value.Value;
-		int blockIndexToCheck = rowToCheck * Size + columnToCheck;
-		
-		if (isOutOfSizeBounds(rowToCheck) || isOutOfSizeBounds(columnToCheck)) {
+			ReportMemory();
 			continue;
 		}
 
-		const auto block = MinesweeperBlocks[blockIndexToCheck];
+		// Cells changed before a queued new game are all in its reset diffs
+		if (NewGamesInFlight > 0) {
+			bHasPendingDiffs = false;
+			continue;
+		}
+
+		// Undo and redo land whole, a half restored board never existed in the game
+		const int32 Remaining = PendingDiffs.Cells.Num() - PendingDiffsOffset;
+		const int32 Count = PendingDiffs.bAtomic ? Remaining : FMath::Min(Budget, Remaining);
+
+		for (int32 i = PendingDiffsOffset; i < PendingDiffsOffset + Count; ++i) {
+			const FMinesweeperCellDiff& Diff = PendingDiffs.Cells[i];
+
+			MinesweeperBlocks[Diff.CellIndex]->ApplyCell(Diff.State, Diff.MinesNear, Diff.bMine);
+		}
 
-		if (block->GetState() != BlockState::REVEALED && block->GetRole() == BlockRole::BLANK) {
-			block->Reveal();
+		PendingDiffsOffset += Count;
+		Budget -= Count;
 
-			BlankTouched(blockIndexToCheck);
+		if (PendingDiffsOffset == PendingDiffs.Cells.Num()) {
+			bHasPendingDiffs = false;
 		}
 	}
 }
 
+void AMinesweeperBlockGrid::ReportMemory() const {
+	const int32 NumCells = MinesweeperBlocks.Num();
+
+	if (NumCells == 0) {
+		return;
+	}
+
+	SIZE_T ActorBytes = 0;
+	SIZE_T MeshBytes = 0;
+	SIZE_T TextBytes = 0;
+	SIZE_T OtherComponentBytes = 0;
+
+	// Meshes and materials are shared by all blocks, so they are counted once and spread over the board
+	TSet<UObject*> SharedAssets;
+
+	TArray<AMinesweeperBlock*> AllBlocks{ MinesweeperBlocks };
+	AllBlocks.Append(BlockPool);
+
+	for (AMinesweeperBlock* Block : AllBlocks) {
+		ActorBytes += CountObjectBytes(Block);
+
+		SharedAssets.Add(Block->BaseMaterial);
+		SharedAssets.Add(Block->BlueMaterial);
+		SharedAssets.Add(Block->OrangeMaterial);
+		SharedAssets.Add(Block->RedMaterial);
+		SharedAssets.Add(Block->BrownMaterial);
+
+		for (UActorComponent* Component : Block->GetComponents()) {
+			if (UStaticMeshComponent* Mesh = Cast<UStaticMeshComponent>(Component)) {
+				MeshBytes += CountObjectBytes(Mesh);
+				SharedAssets.Add(Mesh->GetStaticMesh());
+			}
+			else if (UTextRenderComponent* Text = Cast<UTextRenderComponent>(Component)) {
+				TextBytes += CountObjectBytes(Text);
+				SharedAssets.Add(Text->Font);
+				SharedAssets.Add(Text->TextMaterial);
+			}
+			else {
+				OtherComponentBytes += CountObjectBytes(Component);
+			}
+		}
+	}
+
+	SIZE_T SharedAssetBytes = 0;
+
+	for (UObject* Asset : SharedAssets) {
+		SharedAssetBytes += CountObjectBytes(Asset);
+	}
+
+	const SIZE_T GridBytes = MinesweeperBlocks.GetAllocatedSize() + BlockPool.GetAllocatedSize() + PendingDiffs.Cells.GetAllocatedSize();
+	const SIZE_T BoardBytes = BoardAllocatedSize;
+	const SIZE_T TotalBytes = ActorBytes + MeshBytes + TextBytes + OtherComponentBytes + SharedAssetBytes + GridBytes + BoardBytes;
+
+	auto PerCell = [NumCells](SIZE_T Bytes) {
+		return double(Bytes) / NumCells;
+	};
+
+	UE_LOG(LogTemp, Display, TEXT("Minesweeper board %dx%d, %d cells, %d pooled blocks"), Size, Size, NumCells, BlockPool.Num());
+	UE_LOG(LogTemp, Display, TEXT("  Block actors       %10.1f B/cell"), PerCell(ActorBytes));
+	UE_LOG(LogTemp, Display, TEXT("  Mesh components    %10.1f B/cell"), PerCell(MeshBytes));
+	UE_LOG(LogTemp, Display, TEXT("  Text renderers     %10.1f B/cell"), PerCell(TextBytes));
+	UE_LOG(LogTemp, Display, TEXT("  Other components   %10.1f B/cell"), PerCell(OtherComponentBytes));
+	UE_LOG(LogTemp, Display, TEXT("  Meshes, materials  %10.1f B/cell"), PerCell(SharedAssetBytes));
+	UE_LOG(LogTemp, Display, TEXT("  Block arrays       %10.1f B/cell"), PerCell(GridBytes));
+	UE_LOG(LogTemp, Display, TEXT("  Board and history  %10.1f B/cell"), PerCell(BoardBytes));
+	UE_LOG(LogTemp, Display, TEXT("  Total              %10.1f B/cell"), PerCell(TotalBytes));
+
+	const int32 Budget = CVarMemoryBudgetPerCell.GetValueOnGameThread();
+
+	if (Budget > 0 && PerCell(TotalBytes) > Budget) {
+		UE_LOG(LogTemp, Error, TEXT("Minesweeper board is over memory budget: %.1f B/cell, budget %d B/cell"), PerCell(TotalBytes), Budget);
+	}
+}
+
 #undef LOCTEXT_NAMESPACE
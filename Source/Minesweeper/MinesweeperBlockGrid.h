@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "MinesweeperSimulation.h"
 #include "MinesweeperBlockGrid.generated.h"
 
 class AMinesweeperBlock;
@@ -22,9 +23,42 @@ private:
 	UPROPERTY()
 	TArray<AMinesweeperBlock*> MinesweeperBlocks;
 
-	bool isOutOfSizeBounds(int sizeIndex) {
-		return !(sizeIndex >= 0 && sizeIndex < Size);
-	}
+	/** Hidden blocks left over from bigger boards, reused when the board grows */
+	UPROPERTY()
+	TArray<AMinesweeperBlock*> BlockPool;
+
+	/** Number of blocks along each side currently laid out */
+	int32 BuiltSize{ 0 };
+
+	FVector BlockExtent{ FVector::ZeroVector };
+
+	/** Game logic, runs on its own thread */
+	TUniquePtr<FMinesweeperSimulation> Simulation;
+
+	/** Diffs being applied to blocks over several frames */
+	FMinesweeperDiffBatch PendingDiffs;
+	int32 PendingDiffsOffset{ 0 };
+	bool bHasPendingDiffs{ false };
+
+	/** New games queued but not applied yet, diffs before them are reset anyway and are skipped */
+	int32 NewGamesInFlight{ 0 };
+
+	/** New games applied to the blocks, stamped on commands so clicks on an old layout are dropped */
+	int32 BoardGeneration{ 0 };
+
+	/** Bytes owned by the simulated board, as last measured by the simulation thread */
+	SIZE_T BoardAllocatedSize{ 0 };
+
+	/** Logs bytes per cell of this board by category and checks them against Minesweeper.MemoryBudgetPerCell */
+	void ReportMemory() const;
+
+	/** Queues a command for the board the blocks currently show, false outside of play when there is no simulation */
+	bool EnqueueCommand(FMinesweeperCommand Command);
+
+	void ApplyNewBoard(int32 NewSize, int32 NewMinesCount);
+	void ResizeBlocks();
+	AMinesweeperBlock* SpawnBlock(int32 Row, int32 Column);
+	FVector GetBlockLocation(int32 Row, int32 Column) const;
 
 public:
 	AMinesweeperBlockGrid();
@@ -43,21 +77,39 @@ public:
 	UPROPERTY(Category = Grid, BlueprintReadOnly)
 	int32 MinesCount;
 
+	/** Seed of the mines layout, 0 picks one from the clock */
+	UPROPERTY(Category = Grid, BlueprintReadOnly)
+	int32 Seed;
+
 	/** Spacing of blocks */
 	UPROPERTY(Category=Grid, EditAnywhere, BlueprintReadOnly)
 	float BlockSpacing;
 
+	/** Allows undo/redo of moves */
+	UPROPERTY(Category = Grid, EditAnywhere, BlueprintReadOnly)
+	bool bPracticeMode;
+
 protected:
 	// Begin AActor interface
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Tick(float DeltaTime) override;
 	// End AActor interface
 
 public:
-	UFUNCTION()
-	void FirstTouch();
-	void RevealAll();
-	void BlankTouched(int BlockIndex);
+	/** Starts a new game reusing the existing blocks, growing or shrinking through the block pool once the simulation resets */
+	UFUNCTION(BlueprintCallable, Category = Grid)
+	void ResetBoard(int32 NewSize, int32 NewMinesCount, int32 NewSeed);
+
+	/** Player actions, simulated asynchronously and shown once their diffs arrive */
+	void CheckBlock(int32 BlockIndex);
+	void MarkBlock(int32 BlockIndex);
+	void ChordBlock(int32 BlockIndex);
+	void UndoMove();
+	void RedoMove();
+
+	/** Measures the board on the simulation thread and logs the report once the result arrives */
+	void RequestMemoryReport();
 
 	/** Returns DummyRoot subobject **/
 	FORCEINLINE class USceneComponent* GetDummyRoot() const { return DummyRoot; }
@@ -0,0 +1,245 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MinesweeperBoard.h"
+#include "Minesweeper.h"
+
+void FMinesweeperBoard::Reset(int32 InSize, int32 InMinesCount, int32 InSeed, TArray<FMinesweeperCellDiff>& OutDiffs) {
+	LLM_SCOPE_BYTAG(Minesweeper_Simulation);
+
+	// Visuals of the previous game are switched back to idle blanks
+	for (int32 CellIndex : TouchedCells) {
+		OutDiffs.Add({ CellIndex, BlockState::IDLE, 0, false });
+	}
+
+	InSize = FMath::Clamp(InSize, 1, MaxSize);
+
+	// Number of cells
+	const int32 NumCells = InSize * InSize;
+
+	if (InSize != Size) {
+		States.Init(BlockState::IDLE, NumCells);
+		MinesNear.Init(0, NumCells);
+		Mines.Init(false, NumCells);
+		Touched.Init(false, NumCells);
+	}
+	else {
+		// Only cells written by the previous game need clearing
+		for (int32 CellIndex : TouchedCells) {
+			States[CellIndex] = BlockState::IDLE;
+			Touched[CellIndex] = false;
+		}
+
+		for (int32 MineIndex : MineCells) {
+			Mines[MineIndex] = false;
+			ForEachNeighbour(MineIndex, [this](int32 NeighbourIndex) {
+				MinesNear[NeighbourIndex] = 0;
+			});
+		}
+	}
+
+	TouchedCells.Reset();
+	MineCells.Reset();
+	Regions.Reset();
+
+	Size = InSize;
+	MinesCount = FMath::Clamp(InMinesCount, 0, NumCells - 1);
+	Seed = InSeed;
+	bMinesPlaced = false;
+	RevealedSafeCells = 0;
+	RevealedMines = 0;
+
+	// Outside practice mode nothing is recorded, so the history keeps no snapshot either
+	History.Reset(bPracticeMode ? NumCells : 0);
+}
+
+void FMinesweeperBoard::Check(int32 CellIndex, TArray<FMinesweeperCellDiff>& OutDiffs) {
+	if (!States.IsValidIndex(CellIndex)) {
+		return;
+	}
+
+	if (!bMinesPlaced) {
+		PlaceMines(CellIndex);
+	}
+
+	RevealCell(CellIndex, OutDiffs);
+
+	History.Commit();
+}
+
+void FMinesweeperBoard::Mark(int32 CellIndex, TArray<FMinesweeperCellDiff>& OutDiffs) {
+	if (!States.IsValidIndex(CellIndex)) {
+		return;
+	}
+
+	if (States[CellIndex] == BlockState::IDLE) {
+		SetState(CellIndex, BlockState::MARKED, OutDiffs);
+	}
+	else if (States[CellIndex] == BlockState::MARKED) {
+		SetState(CellIndex, BlockState::IDLE, OutDiffs);
+	}
+
+	History.Commit();
+}
+
+void FMinesweeperBoard::Chord(int32 CellIndex, TArray<FMinesweeperCellDiff>& OutDiffs) {
+	if (!States.IsValidIndex(CellIndex) || States[CellIndex] != BlockState::REVEALED || Mines[CellIndex] || MinesNear[CellIndex] == 0) {
+		return;
+	}
+
+	int32 MarkedNear = 0;
+
+	ForEachNeighbour(CellIndex, [this, &MarkedNear](int32 NeighbourIndex) {
+		MarkedNear += States[NeighbourIndex] == BlockState::MARKED;
+	});
+
+	if (MarkedNear != MinesNear[CellIndex]) {
+		return;
+	}
+
+	ForEachNeighbour(CellIndex, [this, &OutDiffs](int32 NeighbourIndex) {
+		if (States[NeighbourIndex] == BlockState::IDLE) {
+			RevealCell(NeighbourIndex, OutDiffs);
+		}
+	});
+
+	History.Commit();
+}
+
+void FMinesweeperBoard::Undo(TArray<FMinesweeperCellDiff>& OutDiffs) {
+	if (!bPracticeMode) {
+		return;
+	}
+
+	TArray<int32> ChangedCells;
+
+	if (History.Undo(ChangedCells)) {
+		for (int32 CellIndex : ChangedCells) {
+			WriteState(CellIndex, History.GetCellState(CellIndex));
+			AddDiff(CellIndex, OutDiffs);
+		}
+	}
+}
+
+void FMinesweeperBoard::Redo(TArray<FMinesweeperCellDiff>& OutDiffs) {
+	if (!bPracticeMode) {
+		return;
+	}
+
+	TArray<int32> ChangedCells;
+
+	if (History.Redo(ChangedCells)) {
+		for (int32 CellIndex : ChangedCells) {
+			WriteState(CellIndex, History.GetCellState(CellIndex));
+			AddDiff(CellIndex, OutDiffs);
+		}
+	}
+}
+
+EMinesweeperGameStatus FMinesweeperBoard::GetStatus() const {
+	if (RevealedMines > 0) {
+		return EMinesweeperGameStatus::Lost;
+	}
+
+	if (bMinesPlaced && RevealedSafeCells == States.Num() - MinesCount) {
+		return EMinesweeperGameStatus::Won;
+	}
+
+	return EMinesweeperGameStatus::Playing;
+}
+
+SIZE_T FMinesweeperBoard::GetAllocatedSize() const {
+	return States.GetAllocatedSize() + MinesNear.GetAllocatedSize() + Mines.GetAllocatedSize()
+		+ MineCells.GetAllocatedSize() + TouchedCells.GetAllocatedSize() + Touched.GetAllocatedSize()
+		+ Regions.GetAllocatedSize() + History.GetAllocatedSize();
+}
+
+void FMinesweeperBoard::PlaceMines(int32 SafeCellIndex) {
+	if (bMinesPlaced) {
+		return;
+	}
+
+	LLM_SCOPE_BYTAG(Minesweeper_Generation);
+
+	FRandomStream Stream(Seed != 0 ? Seed : FDateTime::Now().ToUnixTimestamp());
+
+	MineCells.Reserve(MinesCount);
+
+	for (int32 i = 0; i < MinesCount; ++i) {
+		int32 MineIndex = Stream.RandRange(0, States.Num() - 1);
+
+		while (MineIndex == SafeCellIndex || Mines[MineIndex]) {
+			MineIndex = Stream.RandRange(0, States.Num() - 1);
+		}
+
+		Mines[MineIndex] = true;
+		MineCells.Add(MineIndex);
+
+		ForEachNeighbour(MineIndex, [this](int32 NeighbourIndex) {
+			MinesNear[NeighbourIndex]++;
+		});
+	}
+
+	Regions.Build(Size, Mines, MinesNear);
+
+	bMinesPlaced = true;
+}
+
+void FMinesweeperBoard::RevealCell(int32 CellIndex, TArray<FMinesweeperCellDiff>& OutDiffs) {
+	if (Mines[CellIndex]) {
+		RevealAll(OutDiffs);
+	}
+	else if (States[CellIndex] != BlockState::REVEALED) {
+		SetState(CellIndex, BlockState::REVEALED, OutDiffs);
+
+		if (MinesNear[CellIndex] == 0) {
+			RevealRegion(Regions.FindRegion(CellIndex), OutDiffs);
+		}
+	}
+}
+
+void FMinesweeperBoard::SetState(int32 CellIndex, BlockState State, TArray<FMinesweeperCellDiff>& OutDiffs) {
+	WriteState(CellIndex, State);
+
+	if (bPracticeMode) {
+		History.SetCellState(CellIndex, State);
+	}
+
+	if (!Touched[CellIndex]) {
+		Touched[CellIndex] = true;
+		TouchedCells.Add(CellIndex);
+	}
+
+	AddDiff(CellIndex, OutDiffs);
+}
+
+void FMinesweeperBoard::WriteState(int32 CellIndex, BlockState State) {
+	const bool bWasRevealed = States[CellIndex] == BlockState::REVEALED;
+	const bool bRevealed = State == BlockState::REVEALED;
+
+	if (bWasRevealed != bRevealed) {
+		int32& RevealedCount = Mines[CellIndex] ? RevealedMines : RevealedSafeCells;
+		RevealedCount += bRevealed ? 1 : -1;
+	}
+
+	States[CellIndex] = State;
+}
+
+void FMinesweeperBoard::RevealRegion(int32 Region, TArray<FMinesweeperCellDiff>& OutDiffs) {
+	for (int32 CellIndex : Regions.GetRegionCells(Region)) {
+		if (States[CellIndex] != BlockState::REVEALED) {
+			SetState(CellIndex, BlockState::REVEALED, OutDiffs);
+		}
+	}
+}
+
+void FMinesweeperBoard::RevealAll(TArray<FMinesweeperCellDiff>& OutDiffs) {
+	for (int32 CellIndex = 0; CellIndex < States.Num(); ++CellIndex) {
+		if (States[CellIndex] != BlockState::REVEALED) {
+			SetState(CellIndex, BlockState::REVEALED, OutDiffs);
+		}
+	}
+}
+
+void FMinesweeperBoard::AddDiff(int32 CellIndex, TArray<FMinesweeperCellDiff>& OutDiffs) const {
+	OutDiffs.Add({ CellIndex, States[CellIndex], MinesNear[CellIndex], Mines[CellIndex] });
+}
@@ -0,0 +1,121 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MinesweeperBlock.h"
+#include "MinesweeperBoardHistory.h"
+#include "MinesweeperRegions.h"
+
+/** New look of a single cell, all a block needs to update its visuals */
+struct FMinesweeperCellDiff
+{
+	int32 CellIndex;
+	BlockState State;
+	uint8 MinesNear;
+	bool bMine;
+};
+
+enum class EMinesweeperGameStatus : uint8
+{
+	Playing,
+	Won,
+	Lost
+};
+
+/**
+ * Game rules and state of a board, independent of actors.
+ * Every action appends the cells it changed to OutDiffs.
+ */
+class FMinesweeperBoard
+{
+public:
+	/** Largest number of cells along a side, keeps the cell count well inside int32 */
+	static constexpr int32 MaxSize = 4096;
+
+	/** Starts a new game. Cells changed by the previous game are reported back as idle blanks */
+	void Reset(int32 InSize, int32 InMinesCount, int32 InSeed, TArray<FMinesweeperCellDiff>& OutDiffs);
+
+	void Check(int32 CellIndex, TArray<FMinesweeperCellDiff>& OutDiffs);
+	void Mark(int32 CellIndex, TArray<FMinesweeperCellDiff>& OutDiffs);
+
+	/** Reveals the idle neighbours of a revealed number once as many of them are marked */
+	void Chord(int32 CellIndex, TArray<FMinesweeperCellDiff>& OutDiffs);
+
+	void Undo(TArray<FMinesweeperCellDiff>& OutDiffs);
+	void Redo(TArray<FMinesweeperCellDiff>& OutDiffs);
+
+	/** Records moves for undo/redo */
+	bool bPracticeMode{ false };
+
+	int32 GetSize() const { return Size; }
+	int32 GetMinesCount() const { return MinesCount; }
+	int32 GetNumCells() const { return States.Num(); }
+	bool AreMinesPlaced() const { return bMinesPlaced; }
+	EMinesweeperGameStatus GetStatus() const;
+
+	BlockState GetState(int32 CellIndex) const { return States[CellIndex]; }
+	bool IsMine(int32 CellIndex) const { return Mines[CellIndex]; }
+	uint8 GetMinesNear(int32 CellIndex) const { return MinesNear[CellIndex]; }
+	const FMinesweeperRegions& GetRegions() const { return Regions; }
+
+	SIZE_T GetAllocatedSize() const;
+
+	/** Done by the first Check, or directly when a board is only analyzed */
+	void PlaceMines(int32 SafeCellIndex);
+
+	/** Calls Visitor with the index of every cell around CellIndex */
+	template<typename VisitorType>
+	void ForEachNeighbour(int32 CellIndex, VisitorType Visitor) const;
+
+private:
+	void RevealCell(int32 CellIndex, TArray<FMinesweeperCellDiff>& OutDiffs);
+	void SetState(int32 CellIndex, BlockState State, TArray<FMinesweeperCellDiff>& OutDiffs);
+
+	/** Writes a state during a game, keeping the revealed counters in sync */
+	void WriteState(int32 CellIndex, BlockState State);
+	void RevealRegion(int32 Region, TArray<FMinesweeperCellDiff>& OutDiffs);
+	void RevealAll(TArray<FMinesweeperCellDiff>& OutDiffs);
+	void AddDiff(int32 CellIndex, TArray<FMinesweeperCellDiff>& OutDiffs) const;
+
+	int32 Size{ 0 };
+	int32 MinesCount{ 0 };
+	int32 Seed{ 0 };
+	bool bMinesPlaced{ false };
+
+	int32 RevealedSafeCells{ 0 };
+	int32 RevealedMines{ 0 };
+
+	TArray<BlockState> States;
+	TArray<uint8> MinesNear;
+	TBitArray<> Mines;
+
+	/** Mines of this game, so a reset only clears what generation wrote */
+	TArray<int32> MineCells;
+
+	/** Openings, labeled once the mines are placed */
+	FMinesweeperRegions Regions;
+
+	/** Cells whose state left idle this game */
+	TArray<int32> TouchedCells;
+	TBitArray<> Touched;
+
+	FMinesweeperBoardHistory History;
+};
+
+template<typename VisitorType>
+void FMinesweeperBoard::ForEachNeighbour(int32 CellIndex, VisitorType Visitor) const
+{
+	const int32 Row = CellIndex / Size;
+	const int32 Column = CellIndex % Size;
+
+	for (int32 RowToCheck = FMath::Max(Row - 1, 0); RowToCheck <= FMath::Min(Row + 1, Size - 1); ++RowToCheck) {
+		for (int32 ColumnToCheck = FMath::Max(Column - 1, 0); ColumnToCheck <= FMath::Min(Column + 1, Size - 1); ++ColumnToCheck) {
+			const int32 CellIndexToCheck = RowToCheck * Size + ColumnToCheck;
+
+			if (CellIndexToCheck != CellIndex) {
+				Visitor(CellIndexToCheck);
+			}
+		}
+	}
+}
@@ -0,0 +1,174 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MinesweeperBoardHistory.h"
+#include "Minesweeper.h"
+
+void FMinesweeperBoardHistory::Reset(int32 InNumCells) {
+	LLM_SCOPE_BYTAG(Minesweeper_History);
+
+	NumCells = InNumCells;
+	PendingStep.Reset();
+	UndoStack.Empty();
+	RedoStack.Empty();
+
+	// A fresh board is a single idle page referenced from everywhere
+	TSharedPtr<FPage> IdlePage = MakeShared<FPage>();
+	for (BlockState& Cell : IdlePage->Cells) {
+		Cell = BlockState::IDLE;
+	}
+
+	TSharedPtr<FChunk> IdleChunk = MakeShared<FChunk>();
+	for (TSharedPtr<FPage>& Page : IdleChunk->Pages) {
+		Page = IdlePage;
+	}
+
+	const int32 NumChunks = FMath::DivideAndRoundUp(NumCells, CellsPerChunk);
+
+	Chunks.Init(IdleChunk, NumChunks);
+	ChunkInPendingStep.Init(false, NumChunks);
+}
+
+BlockState FMinesweeperBoardHistory::GetCellState(int32 CellIndex) const {
+	check(CellIndex >= 0 && CellIndex < NumCells);
+
+	const int32 PageIndex = (CellIndex % CellsPerChunk) / CellsPerPage;
+
+	return Chunks[CellIndex / CellsPerChunk]->Pages[PageIndex]->Cells[CellIndex % CellsPerPage];
+}
+
+void FMinesweeperBoardHistory::SetCellState(int32 CellIndex, BlockState State) {
+	if (GetCellState(CellIndex) == State) {
+		return;
+	}
+
+	LLM_SCOPE_BYTAG(Minesweeper_History);
+
+	const int32 ChunkIndex = CellIndex / CellsPerChunk;
+	TSharedPtr<FChunk>& Chunk = Chunks[ChunkIndex];
+
+	// The chunk before the move goes to the step, the board continues on a copy sharing its pages
+	if (!ChunkInPendingStep[ChunkIndex]) {
+		ChunkInPendingStep[ChunkIndex] = true;
+		PendingStep.Add({ ChunkIndex, Chunk });
+		Chunk = MakeShared<FChunk>(*Chunk);
+	}
+
+	TSharedPtr<FPage>& Page = Chunk->Pages[(CellIndex % CellsPerChunk) / CellsPerPage];
+
+	if (!Page.IsUnique()) {
+		Page = MakeShared<FPage>(*Page);
+	}
+
+	Page->Cells[CellIndex % CellsPerPage] = State;
+}
+
+bool FMinesweeperBoardHistory::Commit() {
+	if (PendingStep.Num() == 0) {
+		return false;
+	}
+
+	LLM_SCOPE_BYTAG(Minesweeper_History);
+
+	for (const FChunkDelta& Delta : PendingStep) {
+		ChunkInPendingStep[Delta.ChunkIndex] = false;
+	}
+
+	UndoStack.Push(MoveTemp(PendingStep));
+	PendingStep.Reset();
+	RedoStack.Reset();
+
+	return true;
+}
+
+bool FMinesweeperBoardHistory::Undo(TArray<int32>& OutChangedCells) {
+	// Unfinished move is undone as a whole
+	Commit();
+
+	if (UndoStack.Num() == 0) {
+		return false;
+	}
+
+	FStep Step = UndoStack.Pop(false);
+	ApplyStep(Step, OutChangedCells);
+	RedoStack.Push(MoveTemp(Step));
+
+	return true;
+}
+
+bool FMinesweeperBoardHistory::Redo(TArray<int32>& OutChangedCells) {
+	if (PendingStep.Num() > 0 || RedoStack.Num() == 0) {
+		return false;
+	}
+
+	FStep Step = RedoStack.Pop(false);
+	ApplyStep(Step, OutChangedCells);
+	UndoStack.Push(MoveTemp(Step));
+
+	return true;
+}
+
+void FMinesweeperBoardHistory::ApplyStep(FStep& Step, TArray<int32>& OutChangedCells) {
+	for (FChunkDelta& Delta : Step) {
+		const FChunk& From = *Chunks[Delta.ChunkIndex];
+		const FChunk& To = *Delta.Chunk;
+
+		// Pages still shared are equal by construction, so only pages the move wrote are scanned
+		for (int32 PageIndex = 0; PageIndex < PagesPerChunk; ++PageIndex) {
+			if (From.Pages[PageIndex] == To.Pages[PageIndex]) {
+				continue;
+			}
+
+			const int32 FirstCell = Delta.ChunkIndex * CellsPerChunk + PageIndex * CellsPerPage;
+
+			for (int32 CellIndex = 0; CellIndex < CellsPerPage; ++CellIndex) {
+				if (From.Pages[PageIndex]->Cells[CellIndex] != To.Pages[PageIndex]->Cells[CellIndex]) {
+					OutChangedCells.Add(FirstCell + CellIndex);
+				}
+			}
+		}
+
+		Swap(Chunks[Delta.ChunkIndex], Delta.Chunk);
+	}
+}
+
+SIZE_T FMinesweeperBoardHistory::GetAllocatedSize() const {
+	TSet<const FChunk*> CountedChunks;
+	TSet<const FPage*> CountedPages;
+	SIZE_T Size = Chunks.GetAllocatedSize() + ChunkInPendingStep.GetAllocatedSize()
+		+ UndoStack.GetAllocatedSize() + RedoStack.GetAllocatedSize();
+
+	auto CountChunk = [&](const TSharedPtr<FChunk>& Chunk) {
+		bool bAlreadyCounted = false;
+		CountedChunks.Add(Chunk.Get(), &bAlreadyCounted);
+
+		if (!bAlreadyCounted) {
+			for (const TSharedPtr<FPage>& Page : Chunk->Pages) {
+				CountedPages.Add(Page.Get());
+			}
+		}
+	};
+
+	auto CountStep = [&](const FStep& Step) {
+		Size += Step.GetAllocatedSize();
+
+		for (const FChunkDelta& Delta : Step) {
+			CountChunk(Delta.Chunk);
+		}
+	};
+
+	for (const TSharedPtr<FChunk>& Chunk : Chunks) {
+		CountChunk(Chunk);
+	}
+
+	CountStep(PendingStep);
+
+	for (const FStep& Step : UndoStack) {
+		CountStep(Step);
+	}
+
+	for (const FStep& Step : RedoStack) {
+		CountStep(Step);
+	}
+
+	return Size + CountedChunks.Num() * sizeof(FChunk) + CountedPages.Num() * sizeof(FPage);
+}
@@ -0,0 +1,71 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MinesweeperBlock.h"
+
+/**
+ * Unlimited undo/redo of block states.
+ * Cells live in pages of 64, pages in chunks of 64. A move clones only the chunks and pages
+ * it writes to, and its undo step keeps just the chunks it replaced, so a step costs memory
+ * and time proportional to the cells it touched, whatever the size of the board.
+ */
+class FMinesweeperBoardHistory
+{
+public:
+	/** Drops all history and starts from a board of idle cells */
+	void Reset(int32 InNumCells);
+
+	BlockState GetCellState(int32 CellIndex) const;
+	void SetCellState(int32 CellIndex, BlockState State);
+
+	/** Closes the current move. Returns false if nothing changed since the last commit */
+	bool Commit();
+
+	/** Steps back/forward one move and fills OutChangedCells with the cells that differ */
+	bool Undo(TArray<int32>& OutChangedCells);
+	bool Redo(TArray<int32>& OutChangedCells);
+
+	/** Bytes owned by the board and all steps, shared chunks and pages are counted once */
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	static constexpr int32 CellsPerPage = 64;
+	static constexpr int32 PagesPerChunk = 64;
+	static constexpr int32 CellsPerChunk = CellsPerPage * PagesPerChunk;
+
+	struct FPage
+	{
+		BlockState Cells[CellsPerPage];
+	};
+
+	struct FChunk
+	{
+		TSharedPtr<FPage> Pages[PagesPerChunk];
+	};
+
+	/** A chunk as it was on the other side of a move */
+	struct FChunkDelta
+	{
+		int32 ChunkIndex;
+		TSharedPtr<FChunk> Chunk;
+	};
+
+	using FStep = TArray<FChunkDelta>;
+
+	/** Swaps the chunks of Step with the board, so the same step undoes what it just applied */
+	void ApplyStep(FStep& Step, TArray<int32>& OutChangedCells);
+
+	/** Board as it is now */
+	TArray<TSharedPtr<FChunk>> Chunks;
+
+	/** Chunks the current move replaced, cloned on the first write of the move */
+	FStep PendingStep;
+	TBitArray<> ChunkInPendingStep;
+
+	TArray<FStep> UndoStack;
+	TArray<FStep> RedoStack;
+
+	int32 NumCells{ 0 };
+};
@@ -0,0 +1,255 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MinesweeperBotBenchmarkCommandlet.h"
+#include "MinesweeperBotProtocol.h"
+#include "MinesweeperBotServer.h"
+#include "SocketSubsystem.h"
+#include "Sockets.h"
+
+using namespace MinesweeperBotProtocol;
+
+/** Connection attempts, an in process listener opens its socket on its own thread */
+static constexpr int32 MaxConnectAttempts = 50;
+
+UMinesweeperBotBenchmarkCommandlet::UMinesweeperBotBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UMinesweeperBotBenchmarkCommandlet::Main(const FString& Params)
+{
+	int32 Port = 7777;
+	int32 Size = 16;
+	int32 MinesCount = 40;
+	int64 NumCommands = 1000000;
+	int32 BatchSize = 64;
+	int32 InFlight = 16;
+	int32 Seed = 1;
+
+	FParse::Value(*Params, TEXT("Port="), Port);
+	FParse::Value(*Params, TEXT("Size="), Size);
+	FParse::Value(*Params, TEXT("Mines="), MinesCount);
+	FParse::Value(*Params, TEXT("Commands="), NumCommands);
+	FParse::Value(*Params, TEXT("BatchSize="), BatchSize);
+	FParse::Value(*Params, TEXT("InFlight="), InFlight);
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+
+	Size = FMath::Clamp(Size, 1, MaxBoardSize);
+	BatchSize = FMath::Max(BatchSize, 1);
+	InFlight = FMath::Max(InFlight, 1);
+
+	TUniquePtr<FMinesweeperBotServer> Server;
+
+	if (FParse::Param(*Params, TEXT("InProcess"))) {
+		Server = MakeUnique<FMinesweeperBotServer>(Port);
+	}
+
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	const TSharedRef<FInternetAddr> Address = FIPv4Endpoint(FIPv4Address::InternalLoopback, Port).ToInternetAddr();
+
+	FSocket* Socket = nullptr;
+
+	for (int32 Attempt = 0; Attempt < MaxConnectAttempts && !Socket; ++Attempt) {
+		Socket = SocketSubsystem->CreateSocket(NAME_Stream, TEXT("MinesweeperBotBenchmark"), false);
+
+		if (!Socket->Connect(*Address)) {
+			SocketSubsystem->DestroySocket(Socket);
+			Socket = nullptr;
+			FPlatformProcess::Sleep(0.1f);
+		}
+	}
+
+	if (!Socket) {
+		UE_LOG(LogTemp, Error, TEXT("Could not connect to a Minesweeper bot server on 127.0.0.1:%d"), Port);
+		return 1;
+	}
+
+	Socket->SetNoDelay(true);
+
+	const int32 NumCells = Size * Size;
+	const int64 NumFrames = FMath::DivideAndRoundUp<int64>(FMath::Max<int64>(NumCommands, 1), BatchSize);
+
+	// What the bot has seen of its current board
+	TArray<BlockState> Known;
+	FRandomStream Random(Seed);
+
+	int64 FramesSent = 0;
+	int64 FramesReceived = 0;
+	int64 CommandsSent = 0;
+	int64 DiffsReceived = 0;
+	int32 GamesWon = 0;
+	int32 GamesLost = 0;
+
+	bool bNeedsNewGame = true;
+	int64 NewGameFrame = 0;
+	int32 NextSeed = Seed;
+
+	auto PickCell = [&](BlockState WantedState) {
+		int32 CellIndex = Random.RandRange(0, NumCells - 1);
+
+		for (int32 Retry = 0; Retry < 4 && Known[CellIndex] != WantedState; ++Retry) {
+			CellIndex = Random.RandRange(0, NumCells - 1);
+		}
+
+		return CellIndex;
+	};
+
+	auto WriteFrame = [&](TArray<uint8>& Buffer) {
+		const int32 FrameStart = Buffer.Num();
+		WriteUInt32(Buffer, 0);
+
+		int32 NumFrameCommands = 0;
+
+		if (bNeedsNewGame) {
+			Buffer.Add(uint8(EOp::NewGame));
+			WriteUInt32(Buffer, Size);
+			WriteUInt32(Buffer, MinesCount);
+			WriteUInt32(Buffer, NextSeed++);
+
+			Known.Init(BlockState::IDLE, NumCells);
+			bNeedsNewGame = false;
+			NewGameFrame = FramesSent;
+			NumFrameCommands++;
+		}
+
+		// Mostly reveals, with some flags and chords so every command is exercised
+		for (; NumFrameCommands < BatchSize; ++NumFrameCommands) {
+			const float Roll = Random.GetFraction();
+
+			if (Roll < 0.1f) {
+				Buffer.Add(uint8(EOp::Flag));
+				WriteUInt32(Buffer, PickCell(BlockState::IDLE));
+			}
+			else if (Roll < 0.2f) {
+				Buffer.Add(uint8(EOp::Chord));
+				WriteUInt32(Buffer, PickCell(BlockState::REVEALED));
+			}
+			else {
+				Buffer.Add(uint8(EOp::Reveal));
+				WriteUInt32(Buffer, PickCell(BlockState::IDLE));
+			}
+		}
+
+		PatchUInt32(Buffer, FrameStart, Buffer.Num() - FrameStart - FrameHeaderSize);
+
+		FramesSent++;
+		CommandsSent += NumFrameCommands;
+	};
+
+	auto ReadResponse = [&](const uint8* Payload, int32 PayloadSize) {
+		if (PayloadSize < ResponseHeaderSize) {
+			return false;
+		}
+
+		const EMinesweeperGameStatus Status = EMinesweeperGameStatus(Payload[0]);
+		const uint32 NumDiffs = ReadUInt32(Payload + 1);
+
+		if (PayloadSize != ResponseHeaderSize + int64(NumDiffs) * DiffSize) {
+			return false;
+		}
+
+		const int64 FrameIndex = FramesReceived++;
+		DiffsReceived += NumDiffs;
+
+		// Frames sent before the latest new game describe a board the bot already left
+		if (FrameIndex < NewGameFrame) {
+			return true;
+		}
+
+		for (const uint8* Diff = Payload + ResponseHeaderSize; Diff < Payload + PayloadSize; Diff += DiffSize) {
+			const FMinesweeperCellDiff CellDiff = UnpackDiff(ReadUInt32(Diff), Diff[4]);
+
+			if (Known.IsValidIndex(CellDiff.CellIndex)) {
+				Known[CellDiff.CellIndex] = CellDiff.State;
+			}
+		}
+
+		if (Status != EMinesweeperGameStatus::Playing && !bNeedsNewGame) {
+			(Status == EMinesweeperGameStatus::Won ? GamesWon : GamesLost)++;
+			bNeedsNewGame = true;
+		}
+
+		return true;
+	};
+
+	TArray<uint8> SendBuffer;
+	TArray<uint8> ReceiveBuffer;
+	int32 ReceivedBytes = 0;
+	bool bFailed = false;
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	while (FramesReceived < NumFrames && !bFailed) {
+		// Keeps the pipeline full, everything queued goes out in one send
+		SendBuffer.Reset();
+
+		while (FramesSent < NumFrames && FramesSent - FramesReceived < InFlight) {
+			WriteFrame(SendBuffer);
+		}
+
+		if (SendBuffer.Num() > 0 && !SendAll(*Socket, SendBuffer.GetData(), SendBuffer.Num())) {
+			bFailed = true;
+			break;
+		}
+
+		if (ReceiveBuffer.Num() < ReceivedBytes + 64 * 1024) {
+			ReceiveBuffer.SetNumUninitialized(ReceivedBytes + 64 * 1024);
+		}
+
+		int32 BytesRead = 0;
+
+		if (!Socket->Recv(ReceiveBuffer.GetData() + ReceivedBytes, ReceiveBuffer.Num() - ReceivedBytes, BytesRead)) {
+			bFailed = true;
+			break;
+		}
+
+		ReceivedBytes += BytesRead;
+
+		const uint8* Data = ReceiveBuffer.GetData();
+		int32 Offset = 0;
+
+		while (ReceivedBytes - Offset >= FrameHeaderSize) {
+			const uint32 PayloadSize = ReadUInt32(Data + Offset);
+
+			if (PayloadSize > uint32(MaxFrameSize) || ReceivedBytes - Offset - FrameHeaderSize < int32(PayloadSize)) {
+				bFailed = PayloadSize > uint32(MaxFrameSize);
+				break;
+			}
+
+			if (!ReadResponse(Data + Offset + FrameHeaderSize, PayloadSize)) {
+				bFailed = true;
+				break;
+			}
+
+			Offset += FrameHeaderSize + PayloadSize;
+		}
+
+		ReceivedBytes -= Offset;
+
+		if (ReceivedBytes > 0 && Offset > 0) {
+			FMemory::Memmove(ReceiveBuffer.GetData(), Data + Offset, ReceivedBytes);
+		}
+	}
+
+	const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+	Socket->Close();
+	SocketSubsystem->DestroySocket(Socket);
+	Server.Reset();
+
+	if (bFailed) {
+		UE_LOG(LogTemp, Error, TEXT("Connection to the Minesweeper bot server failed after %lld of %lld frames"), FramesReceived, NumFrames);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Sent %lld commands in %lld frames of %d, %d in flight, in %.2fs"),
+		CommandsSent, FramesSent, BatchSize, InFlight, Seconds);
+	UE_LOG(LogTemp, Display, TEXT("  %.0f commands/s, %.0f frames/s, %lld diffs received"),
+		CommandsSent / FMath::Max(Seconds, 1e-6), FramesSent / FMath::Max(Seconds, 1e-6), DiffsReceived);
+	UE_LOG(LogTemp, Display, TEXT("  Games on %dx%d with %d mines: %d won, %d lost"), Size, Size, MinesCount, GamesWon, GamesLost);
+
+	return 0;
+}
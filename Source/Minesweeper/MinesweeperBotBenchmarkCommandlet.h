@@ -0,0 +1,25 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MinesweeperBotBenchmarkCommandlet.generated.h"
+
+/**
+ * Local bot client measuring the throughput of FMinesweeperBotServer with pipelined random moves.
+ * Usage: -run=MinesweeperBotBenchmark [-Port=7777] [-InProcess] [-Size=16] [-Mines=40] [-Commands=1000000] [-BatchSize=64] [-InFlight=16] [-Seed=1]
+ * -InProcess starts the server inside the commandlet, otherwise a game started with -MinesweeperBotPort= must be running.
+ */
+UCLASS()
+class UMinesweeperBotBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UMinesweeperBotBenchmarkCommandlet();
+
+	// Begin UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+	// End UCommandlet interface
+};
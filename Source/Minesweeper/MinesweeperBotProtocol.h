@@ -0,0 +1,94 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Sockets.h"
+#include "MinesweeperBoard.h"
+
+/**
+ * Binary protocol spoken by FMinesweeperBotServer, all integers little endian.
+ *
+ * Request frame:  uint32 PayloadSize, then commands back to back
+ *   Reveal  uint8 1, uint32 CellIndex
+ *   Flag    uint8 2, uint32 CellIndex    toggles the mark like a right click
+ *   Chord   uint8 3, uint32 CellIndex
+ *   NewGame uint8 4, uint32 Size, uint32 MinesCount, int32 Seed    seed 0 picks a random board
+ *
+ * NewGame drops the diffs of earlier commands in its frame and reports none itself, every cell starts idle.
+ * Commands on cells outside the board are ignored.
+ *
+ * Response frame: uint32 PayloadSize, uint8 EMinesweeperGameStatus, uint32 NumDiffs, then NumDiffs diffs
+ *   Diff    uint32 CellIndex, uint8 State | MinesNear << 2 | bMine << 6
+ *
+ * A cell shows up at most once per response, with its state after the whole frame,
+ * so responses stay within MaxFrameSize like requests do.
+ *
+ * Every request frame gets exactly one response frame, in order, so clients can keep many frames in flight.
+ */
+namespace MinesweeperBotProtocol
+{
+	enum class EOp : uint8
+	{
+		Reveal = 1,
+		Flag,
+		Chord,
+		NewGame
+	};
+
+	static constexpr int32 FrameHeaderSize = sizeof(uint32);
+	static constexpr int32 ResponseHeaderSize = sizeof(uint8) + sizeof(uint32);
+	static constexpr int32 CellCommandSize = sizeof(uint8) + sizeof(uint32);
+	static constexpr int32 NewGameCommandSize = sizeof(uint8) + 3 * sizeof(uint32);
+	static constexpr int32 DiffSize = sizeof(uint32) + sizeof(uint8);
+
+	/** Larger frames are a protocol error, the connection is closed */
+	static constexpr int32 MaxFrameSize = 16 * 1024 * 1024;
+
+	/** Bigger boards are clamped, so a response revealing every cell still fits in a frame */
+	static constexpr int32 MaxBoardSize = 1024;
+
+	static_assert(MaxBoardSize <= FMinesweeperBoard::MaxSize, "Bot boards must be valid boards");
+	static_assert(ResponseHeaderSize + int64(MaxBoardSize) * MaxBoardSize * DiffSize <= MaxFrameSize, "Responses must fit in a frame");
+
+	inline void WriteUInt32(TArray<uint8>& Buffer, uint32 Value) {
+		const uint8 Bytes[] = { uint8(Value), uint8(Value >> 8), uint8(Value >> 16), uint8(Value >> 24) };
+		Buffer.Append(Bytes, sizeof(Bytes));
+	}
+
+	inline uint32 ReadUInt32(const uint8* Data) {
+		return uint32(Data[0]) | uint32(Data[1]) << 8 | uint32(Data[2]) << 16 | uint32(Data[3]) << 24;
+	}
+
+	/** Overwrites a value written earlier, used to fill in sizes once a frame is complete */
+	inline void PatchUInt32(TArray<uint8>& Buffer, int32 Offset, uint32 Value) {
+		Buffer[Offset] = uint8(Value);
+		Buffer[Offset + 1] = uint8(Value >> 8);
+		Buffer[Offset + 2] = uint8(Value >> 16);
+		Buffer[Offset + 3] = uint8(Value >> 24);
+	}
+
+	inline uint8 PackDiff(const FMinesweeperCellDiff& Diff) {
+		return uint8(Diff.State) | uint8(Diff.MinesNear << 2) | uint8(Diff.bMine ? 1 << 6 : 0);
+	}
+
+	inline FMinesweeperCellDiff UnpackDiff(uint32 CellIndex, uint8 Packed) {
+		return { int32(CellIndex), BlockState(Packed & 3), uint8((Packed >> 2) & 15), (Packed & (1 << 6)) != 0 };
+	}
+
+	/** Blocking send of the whole buffer, false once the socket fails */
+	inline bool SendAll(FSocket& Socket, const uint8* Data, int32 Count) {
+		while (Count > 0) {
+			int32 BytesSent = 0;
+
+			if (!Socket.Send(Data, Count, BytesSent)) {
+				return false;
+			}
+
+			Data += BytesSent;
+			Count -= BytesSent;
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,245 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MinesweeperBotServer.h"
+#include "MinesweeperBotProtocol.h"
+#include "Minesweeper.h"
+#include "Common/TcpListener.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/CommandLine.h"
+#include "Misc/ScopeLock.h"
+#include "SocketSubsystem.h"
+#include "Sockets.h"
+
+using namespace MinesweeperBotProtocol;
+
+/** Bytes asked from the socket at once, a single read usually holds many pipelined frames */
+static constexpr int32 ReceiveChunkSize = 64 * 1024;
+
+FMinesweeperBotServer::FMinesweeperBotServer(int32 Port) {
+	Listener = new FTcpListener(FIPv4Endpoint(FIPv4Address::InternalLoopback, Port));
+	Listener->OnConnectionAccepted().BindRaw(this, &FMinesweeperBotServer::HandleConnectionAccepted);
+
+	UE_LOG(LogTemp, Display, TEXT("Minesweeper bot server listening on 127.0.0.1:%d"), Port);
+}
+
+FMinesweeperBotServer::~FMinesweeperBotServer() {
+	// Listener first, so no connection is accepted while the others shut down
+	delete Listener;
+
+	FScopeLock Lock(&ConnectionsLock);
+	Connections.Empty();
+}
+
+TUniquePtr<FMinesweeperBotServer> FMinesweeperBotServer::CreateFromCommandLine() {
+	int32 Port = 0;
+
+	if (!FParse::Value(FCommandLine::Get(), TEXT("MinesweeperBotPort="), Port) || Port <= 0) {
+		return nullptr;
+	}
+
+	return MakeUnique<FMinesweeperBotServer>(Port);
+}
+
+bool FMinesweeperBotServer::HandleConnectionAccepted(FSocket* Socket, const FIPv4Endpoint& Endpoint) {
+	FScopeLock Lock(&ConnectionsLock);
+
+	Connections.RemoveAll([](const TUniquePtr<FConnection>& Connection) {
+		return Connection->IsFinished();
+	});
+
+	Connections.Add(MakeUnique<FConnection>(Socket, Endpoint));
+
+	UE_LOG(LogTemp, Display, TEXT("Minesweeper bot connected from %s"), *Endpoint.ToString());
+
+	return true;
+}
+
+FMinesweeperBotServer::FConnection::FConnection(FSocket* InSocket, const FIPv4Endpoint& InEndpoint)
+	: Socket(InSocket)
+	, Endpoint(InEndpoint)
+{
+	// Bots replay moves as fast as they can, undo history would only grow
+	Board.bPracticeMode = false;
+
+	Socket->SetNonBlocking(false);
+	Socket->SetNoDelay(true);
+
+	Thread = FRunnableThread::Create(this, TEXT("MinesweeperBotConnection"));
+}
+
+FMinesweeperBotServer::FConnection::~FConnection() {
+	if (Thread) {
+		Thread->Kill(true);
+		delete Thread;
+	}
+
+	Socket->Close();
+	ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+}
+
+uint32 FMinesweeperBotServer::FConnection::Run() {
+	LLM_SCOPE_BYTAG(Minesweeper_Simulation);
+
+	int32 ReceivedBytes = 0;
+
+	while (!bStopping) {
+		if (ReceiveBuffer.Num() < ReceivedBytes + ReceiveChunkSize) {
+			ReceiveBuffer.SetNumUninitialized(ReceivedBytes + ReceiveChunkSize);
+		}
+
+		int32 BytesRead = 0;
+
+		// Fails once the bot disconnects or Stop shuts the socket down
+		if (!Socket->Recv(ReceiveBuffer.GetData() + ReceivedBytes, ReceiveBuffer.Num() - ReceivedBytes, BytesRead)) {
+			break;
+		}
+
+		ReceivedBytes += BytesRead;
+
+		const uint8* Data = ReceiveBuffer.GetData();
+		int32 Offset = 0;
+		bool bValid = true;
+
+		SendBuffer.Reset();
+
+		while (ReceivedBytes - Offset >= FrameHeaderSize) {
+			const uint32 PayloadSize = ReadUInt32(Data + Offset);
+
+			if (PayloadSize > uint32(MaxFrameSize)) {
+				bValid = false;
+				break;
+			}
+
+			if (ReceivedBytes - Offset - FrameHeaderSize < int32(PayloadSize)) {
+				break;
+			}
+
+			if (!ProcessFrame(Data + Offset + FrameHeaderSize, PayloadSize)) {
+				bValid = false;
+				break;
+			}
+
+			Offset += FrameHeaderSize + PayloadSize;
+		}
+
+		// Responses of every complete frame go out together
+		if (SendBuffer.Num() > 0 && !SendAll(*Socket, SendBuffer.GetData(), SendBuffer.Num())) {
+			break;
+		}
+
+		if (!bValid) {
+			UE_LOG(LogTemp, Warning, TEXT("Minesweeper bot %s sent a malformed frame, disconnecting"), *Endpoint.ToString());
+			break;
+		}
+
+		// Start of a frame still on its way is kept for the next read
+		ReceivedBytes -= Offset;
+
+		if (ReceivedBytes > 0 && Offset > 0) {
+			FMemory::Memmove(ReceiveBuffer.GetData(), Data + Offset, ReceivedBytes);
+		}
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Minesweeper bot %s disconnected"), *Endpoint.ToString());
+
+	bFinished = true;
+
+	return 0;
+}
+
+void FMinesweeperBotServer::FConnection::Stop() {
+	bStopping = true;
+
+	// Wakes the blocking receive
+	Socket->Shutdown(ESocketShutdownMode::ReadWrite);
+}
+
+bool FMinesweeperBotServer::FConnection::ProcessFrame(const uint8* Payload, int32 PayloadSize) {
+	const uint8* Cursor = Payload;
+	const uint8* End = Payload + PayloadSize;
+
+	Diffs.Reset();
+
+	while (Cursor < End) {
+		const EOp Op = EOp(*Cursor);
+
+		if (Op == EOp::NewGame) {
+			if (End - Cursor < NewGameCommandSize) {
+				return false;
+			}
+
+			const int32 Size = int32(FMath::Clamp<uint32>(ReadUInt32(Cursor + 1), 1, MaxBoardSize));
+			const int32 MinesCount = int32(FMath::Min<uint32>(ReadUInt32(Cursor + 5), MAX_int32));
+			const int32 Seed = int32(ReadUInt32(Cursor + 9));
+
+			// The bot knows a new board is all idle, clearing the old one is not worth sending
+			ResetDiffs.Reset();
+			Board.Reset(Size, MinesCount, Seed, ResetDiffs);
+			Diffs.Reset();
+
+			Cursor += NewGameCommandSize;
+			continue;
+		}
+
+		if (End - Cursor < CellCommandSize) {
+			return false;
+		}
+
+		const int32 CellIndex = int32(FMath::Min<uint32>(ReadUInt32(Cursor + 1), MAX_int32));
+
+		switch (Op)
+		{
+		case EOp::Reveal:
+			Board.Check(CellIndex, Diffs);
+			break;
+		case EOp::Flag:
+			Board.Mark(CellIndex, Diffs);
+			break;
+		case EOp::Chord:
+			Board.Chord(CellIndex, Diffs);
+			break;
+		default:
+			return false;
+		}
+
+		Cursor += CellCommandSize;
+	}
+
+	if (LastDiffIndex.Num() != Board.GetNumCells()) {
+		LastDiffIndex.Init(INDEX_NONE, Board.GetNumCells());
+	}
+
+	// Diffs carry the whole cell, only the last one of each cell is sent
+	for (int32 DiffIndex = 0; DiffIndex < Diffs.Num(); ++DiffIndex) {
+		LastDiffIndex[Diffs[DiffIndex].CellIndex] = DiffIndex;
+	}
+
+	const int32 FrameStart = SendBuffer.Num();
+	SendBuffer.Reserve(FrameStart + FrameHeaderSize + ResponseHeaderSize + FMath::Min(Diffs.Num(), Board.GetNumCells()) * DiffSize);
+
+	// Payload size and diff count are known once the diffs are written
+	WriteUInt32(SendBuffer, 0);
+	SendBuffer.Add(uint8(Board.GetStatus()));
+	WriteUInt32(SendBuffer, 0);
+
+	int32 NumDiffs = 0;
+
+	for (int32 DiffIndex = 0; DiffIndex < Diffs.Num(); ++DiffIndex) {
+		const FMinesweeperCellDiff& Diff = Diffs[DiffIndex];
+
+		if (LastDiffIndex[Diff.CellIndex] == DiffIndex) {
+			WriteUInt32(SendBuffer, Diff.CellIndex);
+			SendBuffer.Add(PackDiff(Diff));
+			NumDiffs++;
+		}
+	}
+
+	for (const FMinesweeperCellDiff& Diff : Diffs) {
+		LastDiffIndex[Diff.CellIndex] = INDEX_NONE;
+	}
+
+	PatchUInt32(SendBuffer, FrameStart, SendBuffer.Num() - FrameStart - FrameHeaderSize);
+	PatchUInt32(SendBuffer, FrameStart + FrameHeaderSize + sizeof(uint8), NumDiffs);
+
+	return true;
+}
@@ -0,0 +1,74 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Interfaces/IPv4/IPv4Endpoint.h"
+#include "MinesweeperBoard.h"
+
+class FSocket;
+class FTcpListener;
+
+/**
+ * Lets external bots play over MinesweeperBotProtocol.h instead of mouse input.
+ * Listens on loopback only, started by -MinesweeperBotPort=7777 and runs headless with -nullrhi.
+ * Every connection plays its own board on its own thread, away from the game thread and the visible grid.
+ */
+class FMinesweeperBotServer
+{
+public:
+	explicit FMinesweeperBotServer(int32 Port);
+	~FMinesweeperBotServer();
+
+	/** Null unless -MinesweeperBotPort= is on the command line */
+	static TUniquePtr<FMinesweeperBotServer> CreateFromCommandLine();
+
+private:
+	/** One client and its board */
+	class FConnection : public FRunnable
+	{
+	public:
+		FConnection(FSocket* InSocket, const FIPv4Endpoint& InEndpoint);
+		virtual ~FConnection();
+
+		bool IsFinished() const { return bFinished; }
+
+		// Begin FRunnable interface
+		virtual uint32 Run() override;
+		virtual void Stop() override;
+		// End FRunnable interface
+
+	private:
+		/** Runs the commands of one request frame and appends its response frame, false on malformed input */
+		bool ProcessFrame(const uint8* Payload, int32 PayloadSize);
+
+		FSocket* Socket;
+		FIPv4Endpoint Endpoint;
+
+		FMinesweeperBoard Board;
+
+		/** Diffs of the frame in progress, kept to reuse their allocation */
+		TArray<FMinesweeperCellDiff> Diffs;
+		TArray<FMinesweeperCellDiff> ResetDiffs;
+
+		/** Per cell, index of its last diff in the frame in progress, INDEX_NONE between frames */
+		TArray<int32> LastDiffIndex;
+
+		TArray<uint8> ReceiveBuffer;
+		TArray<uint8> SendBuffer;
+
+		FRunnableThread* Thread{ nullptr };
+
+		TAtomic<bool> bStopping{ false };
+		TAtomic<bool> bFinished{ false };
+	};
+
+	/** Called on the listener thread */
+	bool HandleConnectionAccepted(FSocket* Socket, const FIPv4Endpoint& Endpoint);
+
+	FTcpListener* Listener{ nullptr };
+
+	FCriticalSection ConnectionsLock;
+	TArray<TUniquePtr<FConnection>> Connections;
+};
@@ -42,13 +42,11 @@ void AMinesweeperPawn::BeginPlay() {
 	Super::BeginPlay();
 
 	if (Grid){
+		UpdateBounds();
+
 		FVector NewLocation{ 128,128,0 };
 		
 		NewLocation *= Grid->Size;
-
-		LeftCornerBound = { Grid->GetActorLocation().X, Grid->GetActorLocation().Y };
-		RightCornerBound = { Grid->GetActorLocation().X + NewLocation.X * 2, Grid->GetActorLocation().Y + NewLocation.Y * 2 };
-
 		NewLocation += Grid->GetActorLocation();
 		NewLocation.Z = GetActorLocation().Z;
 
@@ -56,10 +54,26 @@ void AMinesweeperPawn::BeginPlay() {
 	}
 }
 
+void AMinesweeperPawn::UpdateBounds() {
+	FVector GridExtent{ 128,128,0 };
+
+	GridExtent *= Grid->Size;
+
+	LeftCornerBound = { Grid->GetActorLocation().X, Grid->GetActorLocation().Y };
+	RightCornerBound = { Grid->GetActorLocation().X + GridExtent.X * 2, Grid->GetActorLocation().Y + GridExtent.Y * 2 };
+
+	BoundsGridSize = Grid->Size;
+}
+
 void AMinesweeperPawn::Tick(float DeltaSeconds)
 {
 	Super::Tick(DeltaSeconds);
 
+	// Board may have been resized by a new game
+	if (Grid && Grid->Size != BoundsGridSize) {
+		UpdateBounds();
+	}
+
 	if (APlayerController* PC = Cast<APlayerController>(GetController()))
 	{
 		FVector Start, Dir, End;
@@ -96,6 +110,10 @@ void AMinesweeperPawn::SetupPlayerInputComponent(UInputComponent* PlayerInputCom
 
 	PlayerInputComponent->BindAction("CheckBlock", EInputEvent::IE_Pressed, this, &AMinesweeperPawn::CheckBlock);
 	PlayerInputComponent->BindAction("MarkBlock", EInputEvent::IE_Pressed, this, &AMinesweeperPawn::MarkBlock);
+	PlayerInputComponent->BindAction("ChordBlock", EInputEvent::IE_Pressed, this, &AMinesweeperPawn::ChordBlock);
+	PlayerInputComponent->BindAction("UndoMove", EInputEvent::IE_Pressed, this, &AMinesweeperPawn::UndoMove);
+	PlayerInputComponent->BindAction("RedoMove", EInputEvent::IE_Pressed, this, &AMinesweeperPawn::RedoMove);
+	PlayerInputComponent->BindAction("NewGame", EInputEvent::IE_Pressed, this, &AMinesweeperPawn::NewGame);
 
 	PlayerInputComponent->BindAxis("MoveRight", this, &AMinesweeperPawn::MoveRight);
 	PlayerInputComponent->BindAxis("MoveUp", this, &AMinesweeperPawn::MoveUp);
@@ -106,7 +124,9 @@ void AMinesweeperPawn::CheckBlock()
 {
 	if (CurrentBlockFocus)
 	{
-		CurrentBlockFocus->CheckBlock();
+		if (CurrentBlockFocus->OwningGrid) {
+			CurrentBlockFocus->OwningGrid->CheckBlock(CurrentBlockFocus->BlockIndex);
+		}
 	}
 }
 
@@ -114,7 +134,43 @@ void AMinesweeperPawn::MarkBlock()
 {
 	if (CurrentBlockFocus)
 	{
-		CurrentBlockFocus->MarkBlock();
+		if (CurrentBlockFocus->OwningGrid) {
+			CurrentBlockFocus->OwningGrid->MarkBlock(CurrentBlockFocus->BlockIndex);
+		}
+	}
+}
+
+void AMinesweeperPawn::ChordBlock()
+{
+	if (CurrentBlockFocus)
+	{
+		if (CurrentBlockFocus->OwningGrid) {
+			CurrentBlockFocus->OwningGrid->ChordBlock(CurrentBlockFocus->BlockIndex);
+		}
+	}
+}
+
+void AMinesweeperPawn::UndoMove()
+{
+	if (Grid)
+	{
+		Grid->UndoMove();
+	}
+}
+
+void AMinesweeperPawn::RedoMove()
+{
+	if (Grid)
+	{
+		Grid->RedoMove();
+	}
+}
+
+void AMinesweeperPawn::NewGame()
+{
+	if (Grid)
+	{
+		Grid->ResetBoard(Grid->Size, Grid->MinesCount, 0);
 	}
 }
 
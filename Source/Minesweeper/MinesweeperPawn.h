@@ -21,6 +21,11 @@ private:
 	FVector2D RightCornerBound{};
 	FVector2D BoundOffset{};
 
+	/** Grid size the camera bounds were computed for */
+	int32 BoundsGridSize{ 0 };
+
+	void UpdateBounds();
+
 	UPROPERTY(Category = Zooming, VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
 	float maxZoomDistance{ 4000.f };
 
@@ -51,6 +56,10 @@ protected:
 
 	void CheckBlock();
 	void MarkBlock();
+	void ChordBlock();
+	void UndoMove();
+	void RedoMove();
+	void NewGame();
 	void TraceForBlock(const FVector& Start, const FVector& End, bool bDrawDebugHelpers);
 
 	UPROPERTY(EditInstanceOnly, BlueprintReadWrite)
@@ -0,0 +1,223 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MinesweeperRegions.h"
+#include "Minesweeper.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+	/** Rows labeled by a single task */
+	constexpr int32 RowsPerStrip = 64;
+
+	/** Roots are always the smallest rank of their set, so every parent precedes its child */
+	int32 FindRoot(TArray<int32>& Parents, int32 Rank) {
+		while (Parents[Rank] != Rank) {
+			Parents[Rank] = Parents[Parents[Rank]];
+			Rank = Parents[Rank];
+		}
+
+		return Rank;
+	}
+
+	void Union(TArray<int32>& Parents, int32 RankA, int32 RankB) {
+		RankA = FindRoot(Parents, RankA);
+		RankB = FindRoot(Parents, RankB);
+
+		if (RankA < RankB) {
+			Parents[RankB] = RankA;
+		}
+		else if (RankB < RankA) {
+			Parents[RankA] = RankB;
+		}
+	}
+}
+
+void FMinesweeperRegions::Build(int32 InSize, const TBitArray<>& Mines, const TArray<uint8>& MinesNear) {
+	LLM_SCOPE_BYTAG(Minesweeper_Generation);
+
+	Size = InSize;
+
+	const int32 NumCells = Size * Size;
+	const int32 NumWords = FMath::DivideAndRoundUp(NumCells, 64);
+
+	ZeroCellWords.Init(0, NumWords);
+	ZeroCellWordRanks.SetNumUninitialized(NumWords);
+
+	for (int32 CellIndex = 0; CellIndex < NumCells; ++CellIndex) {
+		if (!Mines[CellIndex] && MinesNear[CellIndex] == 0) {
+			ZeroCellWords[CellIndex / 64] |= uint64(1) << (CellIndex % 64);
+		}
+	}
+
+	int32 NumZeroCells = 0;
+
+	for (int32 WordIndex = 0; WordIndex < NumWords; ++WordIndex) {
+		ZeroCellWordRanks[WordIndex] = NumZeroCells;
+		NumZeroCells += FPlatformMath::CountBits(ZeroCellWords[WordIndex]);
+	}
+
+	// Parents of the union-find, later overwritten in place with region ids
+	ZeroCellRegions.SetNumUninitialized(NumZeroCells);
+
+	for (int32 Rank = 0; Rank < NumZeroCells; ++Rank) {
+		ZeroCellRegions[Rank] = Rank;
+	}
+
+	// Strips only union cells inside their own rows, so they never touch each other's parents
+	const int32 NumStrips = FMath::DivideAndRoundUp(Size, RowsPerStrip);
+
+	ParallelFor(NumStrips, [this](int32 StripIndex) {
+		const int32 FirstRow = StripIndex * RowsPerStrip;
+		const int32 LastRow = FMath::Min(FirstRow + RowsPerStrip, Size) - 1;
+
+		for (int32 Row = FirstRow; Row <= LastRow; ++Row) {
+			for (int32 Column = 0; Column < Size; ++Column) {
+				const int32 CellIndex = Row * Size + Column;
+
+				if (!IsZeroCell(CellIndex)) {
+					continue;
+				}
+
+				const int32 Rank = GetZeroRank(CellIndex);
+
+				if (Column > 0 && IsZeroCell(CellIndex - 1)) {
+					Union(ZeroCellRegions, Rank, GetZeroRank(CellIndex - 1));
+				}
+
+				if (Row == FirstRow) {
+					continue;
+				}
+
+				for (int32 ColumnToCheck = FMath::Max(Column - 1, 0); ColumnToCheck <= FMath::Min(Column + 1, Size - 1); ++ColumnToCheck) {
+					const int32 CellIndexToCheck = (Row - 1) * Size + ColumnToCheck;
+
+					if (IsZeroCell(CellIndexToCheck)) {
+						Union(ZeroCellRegions, Rank, GetZeroRank(CellIndexToCheck));
+					}
+				}
+			}
+		}
+	});
+
+	// Stitch each strip to the last row of the strip above
+	for (int32 Row = RowsPerStrip; Row < Size; Row += RowsPerStrip) {
+		for (int32 Column = 0; Column < Size; ++Column) {
+			const int32 CellIndex = Row * Size + Column;
+
+			if (!IsZeroCell(CellIndex)) {
+				continue;
+			}
+
+			for (int32 ColumnToCheck = FMath::Max(Column - 1, 0); ColumnToCheck <= FMath::Min(Column + 1, Size - 1); ++ColumnToCheck) {
+				const int32 CellIndexToCheck = (Row - 1) * Size + ColumnToCheck;
+
+				if (IsZeroCell(CellIndexToCheck)) {
+					Union(ZeroCellRegions, GetZeroRank(CellIndex), GetZeroRank(CellIndexToCheck));
+				}
+			}
+		}
+	}
+
+	// Parents precede children, so a single ascending pass both flattens the sets and numbers them
+	int32 NumRegions = 0;
+
+	for (int32 Rank = 0; Rank < NumZeroCells; ++Rank) {
+		ZeroCellRegions[Rank] = ZeroCellRegions[Rank] == Rank ? NumRegions++ : ZeroCellRegions[ZeroCellRegions[Rank]];
+	}
+
+	// Regions bordering a cell, each listed once
+	auto GatherRegions = [this](int32 CellIndex, int32 (&OutRegions)[8]) {
+		int32 NumFound = 0;
+
+		if (IsZeroCell(CellIndex)) {
+			OutRegions[NumFound++] = FindRegion(CellIndex);
+			return NumFound;
+		}
+
+		const int32 Row = CellIndex / Size;
+		const int32 Column = CellIndex % Size;
+
+		for (int32 RowToCheck = FMath::Max(Row - 1, 0); RowToCheck <= FMath::Min(Row + 1, Size - 1); ++RowToCheck) {
+			for (int32 ColumnToCheck = FMath::Max(Column - 1, 0); ColumnToCheck <= FMath::Min(Column + 1, Size - 1); ++ColumnToCheck) {
+				const int32 Region = FindRegion(RowToCheck * Size + ColumnToCheck);
+
+				if (Region != INDEX_NONE && !TArrayView<int32>(OutRegions, NumFound).Contains(Region)) {
+					OutRegions[NumFound++] = Region;
+				}
+			}
+		}
+
+		return NumFound;
+	};
+
+	int32 Regions[8];
+
+	RegionOffsets.Init(0, NumRegions + 1);
+
+	for (int32 CellIndex = 0; CellIndex < NumCells; ++CellIndex) {
+		if (Mines[CellIndex]) {
+			continue;
+		}
+
+		const int32 NumFound = GatherRegions(CellIndex, Regions);
+
+		for (int32 i = 0; i < NumFound; ++i) {
+			RegionOffsets[Regions[i] + 1]++;
+		}
+	}
+
+	for (int32 Region = 0; Region < NumRegions; ++Region) {
+		RegionOffsets[Region + 1] += RegionOffsets[Region];
+	}
+
+	TArray<int32> FillOffsets(RegionOffsets.GetData(), NumRegions);
+	RegionCells.SetNumUninitialized(RegionOffsets[NumRegions]);
+
+	for (int32 CellIndex = 0; CellIndex < NumCells; ++CellIndex) {
+		if (Mines[CellIndex]) {
+			continue;
+		}
+
+		const int32 NumFound = GatherRegions(CellIndex, Regions);
+
+		for (int32 i = 0; i < NumFound; ++i) {
+			RegionCells[FillOffsets[Regions[i]]++] = CellIndex;
+		}
+	}
+}
+
+void FMinesweeperRegions::Reset() {
+	Size = 0;
+	ZeroCellWords.Reset();
+	ZeroCellWordRanks.Reset();
+	ZeroCellRegions.Reset();
+	RegionOffsets.Reset();
+	RegionCells.Reset();
+}
+
+int32 FMinesweeperRegions::FindRegion(int32 CellIndex) const {
+	if (!IsZeroCell(CellIndex)) {
+		return INDEX_NONE;
+	}
+
+	return ZeroCellRegions[GetZeroRank(CellIndex)];
+}
+
+TArrayView<const int32> FMinesweeperRegions::GetRegionCells(int32 Region) const {
+	return TArrayView<const int32>(RegionCells.GetData() + RegionOffsets[Region], RegionOffsets[Region + 1] - RegionOffsets[Region]);
+}
+
+SIZE_T FMinesweeperRegions::GetAllocatedSize() const {
+	return ZeroCellWords.GetAllocatedSize() + ZeroCellWordRanks.GetAllocatedSize() + ZeroCellRegions.GetAllocatedSize()
+		+ RegionOffsets.GetAllocatedSize() + RegionCells.GetAllocatedSize();
+}
+
+bool FMinesweeperRegions::IsZeroCell(int32 CellIndex) const {
+	return CellIndex >= 0 && CellIndex < Size * Size && (ZeroCellWords[CellIndex / 64] >> (CellIndex % 64)) & 1;
+}
+
+int32 FMinesweeperRegions::GetZeroRank(int32 CellIndex) const {
+	const uint64 LowerBits = ZeroCellWords[CellIndex / 64] & ((uint64(1) << (CellIndex % 64)) - 1);
+
+	return ZeroCellWordRanks[CellIndex / 64] + FPlatformMath::CountBits(LowerBits);
+}
@@ -0,0 +1,49 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Openings of a generated board: connected zero cells together with their numbered border.
+ * Only zero cells carry a 32-bit region id, looked up through a rank over a zero cell bitmap,
+ * and the cells of every region are stored back to back.
+ */
+class FMinesweeperRegions
+{
+public:
+	/** Labels the board with a union-find pass over row strips in parallel, then merges the strips */
+	void Build(int32 InSize, const TBitArray<>& Mines, const TArray<uint8>& MinesNear);
+
+	void Reset();
+
+	/** Region of a zero cell, INDEX_NONE for mines and numbered cells */
+	int32 FindRegion(int32 CellIndex) const;
+
+	/** Zero cells and their border, every cell listed once */
+	TArrayView<const int32> GetRegionCells(int32 Region) const;
+
+	int32 GetNumRegions() const { return FMath::Max(RegionOffsets.Num() - 1, 0); }
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	bool IsZeroCell(int32 CellIndex) const;
+
+	/** Number of zero cells before CellIndex */
+	int32 GetZeroRank(int32 CellIndex) const;
+
+	int32 Size{ 0 };
+
+	/** One bit per cell, set for non mine cells without mines around */
+	TArray<uint64> ZeroCellWords;
+
+	/** Zero cells before each word */
+	TArray<int32> ZeroCellWordRanks;
+
+	/** Region of every zero cell, indexed by zero rank */
+	TArray<int32> ZeroCellRegions;
+
+	TArray<int32> RegionOffsets;
+	TArray<int32> RegionCells;
+};
@@ -0,0 +1,116 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MinesweeperSimulation.h"
+#include "Minesweeper.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+
+FMinesweeperSimulation::FMinesweeperSimulation(bool bPracticeMode) {
+	Board.bPracticeMode = bPracticeMode;
+
+	// Without threads commands are simulated right away on the caller
+	if (FPlatformProcess::SupportsMultithreading()) {
+		CommandEvent = FPlatformProcess::GetSynchEventFromPool();
+		Thread = FRunnableThread::Create(this, TEXT("MinesweeperSimulation"));
+	}
+}
+
+FMinesweeperSimulation::~FMinesweeperSimulation() {
+	if (Thread) {
+		Thread->Kill(true);
+		delete Thread;
+	}
+
+	if (CommandEvent) {
+		FPlatformProcess::ReturnSynchEventToPool(CommandEvent);
+	}
+}
+
+void FMinesweeperSimulation::EnqueueCommand(const FMinesweeperCommand& Command) {
+	if (!Thread) {
+		ProcessCommand(Command);
+		return;
+	}
+
+	Commands.Enqueue(Command);
+	CommandEvent->Trigger();
+}
+
+bool FMinesweeperSimulation::DequeueDiffs(FMinesweeperDiffBatch& OutBatch) {
+	return Diffs.Dequeue(OutBatch);
+}
+
+uint32 FMinesweeperSimulation::Run() {
+	LLM_SCOPE_BYTAG(Minesweeper_Simulation);
+
+	while (!bStopping) {
+		FMinesweeperCommand Command;
+
+		while (!bStopping && Commands.Dequeue(Command)) {
+			ProcessCommand(Command);
+		}
+
+		CommandEvent->Wait();
+	}
+
+	return 0;
+}
+
+void FMinesweeperSimulation::Stop() {
+	bStopping = true;
+
+	if (CommandEvent) {
+		CommandEvent->Trigger();
+	}
+}
+
+void FMinesweeperSimulation::ProcessCommand(const FMinesweeperCommand& Command) {
+	LLM_SCOPE_BYTAG(Minesweeper_Simulation);
+
+	// Cell indexes of an older board point at other cells after a resize
+	const bool bTargetsBoard = Command.Type != EMinesweeperCommandType::NewGame && Command.Type != EMinesweeperCommandType::ReportMemory;
+
+	if (bTargetsBoard && Command.Generation != Generation) {
+		return;
+	}
+
+	FMinesweeperDiffBatch Batch;
+
+	switch (Command.Type)
+	{
+	case EMinesweeperCommandType::Check:
+		Board.Check(Command.CellIndex, Batch.Cells);
+		break;
+	case EMinesweeperCommandType::Mark:
+		Board.Mark(Command.CellIndex, Batch.Cells);
+		break;
+	case EMinesweeperCommandType::Chord:
+		Board.Chord(Command.CellIndex, Batch.Cells);
+		break;
+	case EMinesweeperCommandType::Undo:
+		Board.Undo(Batch.Cells);
+		Batch.bAtomic = true;
+		break;
+	case EMinesweeperCommandType::Redo:
+		Board.Redo(Batch.Cells);
+		Batch.bAtomic = true;
+		break;
+	case EMinesweeperCommandType::NewGame:
+		Board.Reset(Command.Size, Command.MinesCount, Command.Seed, Batch.Cells);
+		Generation++;
+		Batch.NewSize = Board.GetSize();
+		Batch.NewMinesCount = Board.GetMinesCount();
+		Batch.BoardAllocatedSize = Board.GetAllocatedSize();
+		break;
+	case EMinesweeperCommandType::ReportMemory:
+		Batch.BoardAllocatedSize = Board.GetAllocatedSize();
+		Batch.bReportMemory = true;
+		break;
+	default:
+		break;
+	}
+
+	if (Batch.Cells.Num() > 0 || Batch.NewSize > 0 || Batch.bReportMemory) {
+		Diffs.Enqueue(MoveTemp(Batch));
+	}
+}
@@ -0,0 +1,94 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Containers/Queue.h"
+#include "MinesweeperBoard.h"
+
+enum class EMinesweeperCommandType : uint8
+{
+	Check,
+	Mark,
+	Chord,
+	Undo,
+	Redo,
+	NewGame,
+	ReportMemory
+};
+
+/** Player action sent to the simulation thread */
+struct FMinesweeperCommand
+{
+	EMinesweeperCommandType Type;
+
+	/** Number of new games the sender had seen, commands aimed at an older board are dropped */
+	int32 Generation{ 0 };
+
+	/** Target of Check, Mark and Chord */
+	int32 CellIndex{ -1 };
+
+	/** Board of NewGame */
+	int32 Size{ 0 };
+	int32 MinesCount{ 0 };
+	int32 Seed{ 0 };
+};
+
+/** Cells changed by one command, applied by the game thread in order */
+struct FMinesweeperDiffBatch
+{
+	TArray<FMinesweeperCellDiff> Cells;
+
+	/** Set by NewGame. Cells still use the previous layout, the board is resized right after they are applied */
+	int32 NewSize{ 0 };
+	int32 NewMinesCount{ 0 };
+
+	/** Applied in a single frame regardless of Minesweeper.MaxBlockUpdatesPerFrame, set by Undo and Redo */
+	bool bAtomic{ false };
+
+	/** Bytes owned by the board, only measured by NewGame and ReportMemory since it walks the whole history */
+	SIZE_T BoardAllocatedSize{ 0 };
+	bool bReportMemory{ false };
+};
+
+/**
+ * Runs a board on its own thread.
+ * The game thread is the only producer of commands and the only consumer of diffs,
+ * so both directions go through lock free single producer single consumer queues.
+ */
+class FMinesweeperSimulation : public FRunnable
+{
+public:
+	FMinesweeperSimulation(bool bPracticeMode);
+	virtual ~FMinesweeperSimulation();
+
+	/** Game thread only */
+	void EnqueueCommand(const FMinesweeperCommand& Command);
+
+	/** Game thread only */
+	bool DequeueDiffs(FMinesweeperDiffBatch& OutBatch);
+
+	// Begin FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	// End FRunnable interface
+
+private:
+	void ProcessCommand(const FMinesweeperCommand& Command);
+
+	FMinesweeperBoard Board;
+
+	/** New games processed so far, simulation thread only */
+	int32 Generation{ 0 };
+
+	TQueue<FMinesweeperCommand, EQueueMode::Spsc> Commands;
+	TQueue<FMinesweeperDiffBatch, EQueueMode::Spsc> Diffs;
+
+	/** Wakes the thread when commands arrive */
+	FEvent* CommandEvent{ nullptr };
+
+	FRunnableThread* Thread{ nullptr };
+
+	TAtomic<bool> bStopping{ false };
+};